@@ -24,10 +24,22 @@
 
 #pragma once
 
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
 #include <string_view>
 #include <span>
+#include <tuple>
 #include <map>
+#include <mutex>
+#include <new>
 #include <vector>
 
 #pragma region Configuration
@@ -64,14 +76,21 @@
 
     // TypeId/Hashing
     #ifndef ETI_TYPE_ID_TYPE
+        // std::uint64_t or ::eti::TypeId128 (two 64 bits hashes of type name with different seeds)
         #define ETI_TYPE_ID_TYPE std::uint64_t
     #endif
 
     #ifndef ETI_HASH_FUNCTION
+        // std::uint64_t(std::string_view str), TypeId128 also call it with seed: (str, ETI_HASH_SEED_HIGH)
         //#define ETI_HASH_FUNCTION ::eti::utils::HashFNV1
         #define ETI_HASH_FUNCTION ::eti::utils::HashFNV1WithPrime
         #define ETI_HASH_SEED 0xCBF29CE484222325ull
     #endif
+
+    #ifndef ETI_HASH_SEED_HIGH
+        // seed of high 64 bits of TypeId128
+        #define ETI_HASH_SEED_HIGH 0x9E3779B97F4A7C15ull
+    #endif
         
     #ifndef ETI_TYPE_NAME_FUNCTION
         // Function Type Name
@@ -84,12 +103,18 @@
         #define ETI_COMMON_TYPE 1
     #endif
 
+    #ifndef ETI_METHOD_ARGUMENTS_MAX
+        // Max arguments count of a reflected method, arguments pointers are packed
+        // on the stack when calling method so call never allocate.
+        #define ETI_METHOD_ARGUMENTS_MAX 16
+    #endif
+
     #ifndef ETI_REPOSITORY
         // Enable Repository
         //
         //  All type will self register so it's possible to make at runtime:
-        //      const Type* type = Repository::GetTypes(fooId);
-        //      const Type* type = Repository::GetTypes("Foo");
+        //      const Type* type = Repository::Instance().GetType(fooId);
+        //      const Type* type = Repository::Instance().GetType("Foo");
         //
         // For stuff like serialization...
         //
@@ -109,18 +134,51 @@ namespace eti
 
 #pragma region Forwards
 
+    // 128 bits TypeId (see ETI_TYPE_ID_TYPE)
+    struct TypeId128
+    {
+        std::uint64_t Low = 0;
+        std::uint64_t High = 0;
+
+        constexpr TypeId128() = default;
+        constexpr TypeId128(std::uint64_t low, std::uint64_t high = 0) : Low(low), High(high) {}
+
+        // low first, different ids almost always differ there
+        constexpr bool operator==(const TypeId128& other) const { return Low == other.Low && High == other.High; }
+        constexpr std::strong_ordering operator<=>(const TypeId128& other) const = default;
+    };
+
     using TypeId = ETI_TYPE_ID_TYPE;
     struct Type;
     struct Declaration;
     struct Variable;
     struct Property;
     struct Method;
+    struct EnumEntry;
     enum class Kind : std::uint8_t;
     class Attribute;
     template<typename T>
     const Type& TypeOf();
     template<typename T>
     const Type& TypeOfForward();
+    template<typename T>
+    struct IsTriviallyRelocatable;
+
+    // type operations and method thunks are plain function pointers generated per T / per method (no captured state)
+    using NewFunction = void* (*)();
+    using DeleteFunction = void (*)(void* /* dst */);
+    using ConstructFunction = void (*)(void* /* dst */);
+    using CopyConstructFunction = void (*)(void* /* src */, void* /* dst */);
+    using MoveConstructFunction = void (*)(void* /* src */, void* /* dst */);
+    using DestructFunction = void (*)(void* /* dst */);
+    // on count contiguous elements (stride is Type::Size), memset/memcpy/no-op for trivial T
+    using ConstructNFunction = void (*)(void* /* dst */, std::size_t /* count */);
+    using CopyConstructNFunction = void (*)(const void* /* src */, void* /* dst */, std::size_t /* count */);
+    using MoveConstructNFunction = void (*)(void* /* src */, void* /* dst */, std::size_t /* count */);
+    using DestructNFunction = void (*)(void* /* dst */, std::size_t /* count */);
+    // move count elements to dst then destruct src ones, ranges can overlap (like memmove)
+    using RelocateFunction = void (*)(void* /* src */, void* /* dst */, std::size_t /* count */);
+    using MethodFunction = void (*)(void* /* obj */, void* /* ret */, std::span<void*> /* args */);
 
 #pragma endregion
 
@@ -206,14 +264,14 @@ namespace eti
         template<typename T>
         constexpr bool IsMethodConst = IsMethodConstImpl<T>::value;
 
-        // Hash constexpr string_view to constexpr TypeId
-        constexpr TypeId HashFNV1WithPrime(const std::string_view str, TypeId hash = ETI_HASH_SEED)
+        // Hash constexpr string_view to constexpr 64 bits hash
+        constexpr std::uint64_t HashFNV1WithPrime(const std::string_view str, std::uint64_t hash = ETI_HASH_SEED)
         {
             std::uint64_t prime = 0x100000001B3ull;
 
             for (char c : str)
             {
-                hash ^= static_cast<TypeId>(c);
+                hash ^= static_cast<std::uint64_t>(c);
                 hash *= prime;
                 hash = (hash << 5) | (hash >> (64 - 5));
                 hash ^= 0x27d4eb2d;
@@ -222,22 +280,35 @@ namespace eti
             return hash;
         }
 
-        // Simple hash constexpr string_view to constexpr TypeId (faster)
-        constexpr TypeId HashFNV1(std::string_view str, TypeId hash = ETI_HASH_SEED)
+        // Simple hash constexpr string_view to constexpr 64 bits hash (faster)
+        constexpr std::uint64_t HashFNV1(std::string_view str, std::uint64_t hash = ETI_HASH_SEED)
         {
             for (char c : str)
             {
-                hash ^= static_cast<TypeId>(c);
+                hash ^= static_cast<std::uint64_t>(c);
                 hash *= 0x100000001B3ull;
             }
             return hash;
         }
 
+        template<typename ID>
+        constexpr ID GetStringHashAs(const std::string_view str)
+        {
+            if constexpr (std::is_same_v<ID, TypeId128>)
+                return TypeId128(ETI_HASH_FUNCTION(str), ETI_HASH_FUNCTION(str, ETI_HASH_SEED_HIGH));
+            else
+                return ETI_HASH_FUNCTION(str);
+        }
+
         constexpr TypeId GetStringHash(const std::string_view str)
         {
-            return ETI_HASH_FUNCTION(str);
+            return GetStringHashAs<TypeId>(str);
         }
 
+        // 64 bits of id, to index hash tables
+        constexpr std::uint64_t GetIdBits(std::uint64_t id) { return id; }
+        constexpr std::uint64_t GetIdBits(const TypeId128& id) { return id.Low; }
+
         // cast void* to T and remove ref if needed
         template<typename T>
         auto VoidPrtToTypeArg(void* ptr) -> decltype(auto)
@@ -307,52 +378,14 @@ namespace eti
             CallStaticFunctionImpl<RETURN, ARGS...>::Call(func, obj, ret, args);
         }
 
-        // static lambda function call
-
-        // static lambda function call with return value
-        template<typename RETURN, typename... ARGS>
-        struct CallStaticLambdaFunctionImpl
-        {
-            static void Call(std::function<RETURN(ARGS...)> func, void*, void* ret, std::span<void*> args)
-            {
-                ETI_ASSERT(ret != nullptr, "call function that return void should have ret arg to nullptr");
-                auto args_tuple = utils::VoidArgsToTuple<ARGS...>(args, std::index_sequence_for<ARGS...>{});
-                std::apply([&](auto... applyArgs) { *((RETURN*)ret) = func(*applyArgs...); }, args_tuple);
-            }
-        };
-
-        // static lambda function call with return ref
-        template<typename RETURN, typename... ARGS>
-        struct CallStaticLambdaFunctionImpl<RETURN&, ARGS...>
-        {
-            static void Call(std::function<RETURN&(ARGS...)> func, void*, void* ret, std::span<void*> args)
-            {
-                ETI_ASSERT(ret != nullptr, "call function that return void should have ret arg to nullptr");
-                auto args_tuple = utils::VoidArgsToTuple<ARGS...>(args, std::index_sequence_for<ARGS...>{});
-                std::apply([&](auto... applyArgs) { (*(void**)ret) = &func(*applyArgs...); }, args_tuple);
-            }
-        };
-
-        // static lambda function call no return
-        template<typename... ARGS>
-        struct CallStaticLambdaFunctionImpl<void, ARGS...>
-        {
-            static void Call(std::function<void(ARGS...)> func, void*, void* ret, std::span<void*> args)
-            {
-                ETI_ASSERT(ret == nullptr, "call function that return void should have ret arg to nullptr");
-                auto args_tuple = VoidArgsToTuple<ARGS...>(args, std::index_sequence_for<ARGS...>{});
-                std::apply([&](auto... applyArgs) { func(*applyArgs...); }, args_tuple);
-            }
-        };
-
-        // static lambda switch
+        // static lambda function call, lambda are captureless and converted to function pointer
 
         template<typename RETURN, typename... ARGS>
-        void CallStaticLambda(std::function<RETURN(ARGS...)> func, void* obj, void* ret, std::span<void*> args)
+        void CallStaticLambda(RETURN(*func)(ARGS...), void* obj, void* ret, std::span<void*> args)
         {
             ETI_ASSERT(sizeof...(ARGS) == args.size(), "invalid size of args");
             ETI_ASSERT(obj == nullptr, "call lamda member function should have obj set to  nullptr");
-            CallStaticLambdaFunctionImpl<RETURN, ARGS...>::Call(func, obj, ret, args);
+            CallStaticFunctionImpl<RETURN, ARGS...>::Call(func, obj, ret, args);
         }
 
         // member function call
@@ -462,16 +495,16 @@ namespace eti
         static constexpr bool HaveGetTypeStatic = HaveGetTypeStaticImpl<T>::value;
 
         template<typename T>
-        static std::function<void*()> GetNew()
+        static NewFunction GetNew()
         {
             if constexpr (std::is_default_constructible_v<T>)
-                return []() { return new T(); };
+                return []() -> void* { return new T(); };
             else
                 return nullptr;
         }
 
         template<typename T>
-        static std::function<void(void* /* dst */)> GetDelete()
+        static DeleteFunction GetDelete()
         {
             if constexpr (std::is_default_constructible_v<T>)
                 return [](void* dst) { delete (T*)dst; };
@@ -480,7 +513,7 @@ namespace eti
         }
 
         template<typename T>
-        static std::function<void(void* /* dst */)> GetConstruct()
+        static ConstructFunction GetConstruct()
         {
             if constexpr (std::is_default_constructible_v<T>)
                 return [](void* dst) { new (dst) T(); };
@@ -489,7 +522,7 @@ namespace eti
         }
 
         template<typename T>
-        static std::function<void(void* /* src */, void* /* dst */)> GetCopyConstruct()
+        static CopyConstructFunction GetCopyConstruct()
         {
             if constexpr (std::is_copy_constructible_v<T>)
                 return [](void* src, void* dst) { new (dst) T(*(T*)src); };
@@ -498,19 +531,101 @@ namespace eti
         }
 
         template<typename T>
-        static std::function<void(void* /* src */, void* /* dst */)> GetMoveConstruct()
+        static MoveConstructFunction GetMoveConstruct()
         {
-            if constexpr (std::is_default_constructible_v<T>)
+            if constexpr (std::is_move_constructible_v<T>)
                 return [](void* src, void* dst) { new (dst) T(std::move(*(T*)src)); };
             else
                 return nullptr;
         }
 
         template<typename T>
-        static std::function<void(void* /* dst */)> GetDestruct()
+        static DestructFunction GetDestruct()
         {
             return [](void* dst) { ((T*)dst)->~T(); };
         }
+
+        // value initialized like T(), zero for trivial T
+        // ConstructN/CopyConstructN/MoveConstructN destruct already constructed elements if one throw (nothing is left constructed)
+        template<typename T>
+        static ConstructNFunction GetConstructN()
+        {
+            if constexpr (std::is_trivially_default_constructible_v<T>)
+                return [](void* dst, std::size_t count) { if (count != 0) std::memset(dst, 0, count * sizeof(T)); };
+            else if constexpr (std::is_default_constructible_v<T>)
+                return [](void* dst, std::size_t count) { std::uninitialized_value_construct_n((T*)dst, count); };
+            else
+                return nullptr;
+        }
+
+        template<typename T>
+        static CopyConstructNFunction GetCopyConstructN()
+        {
+            if constexpr (std::is_trivially_copyable_v<T> && std::is_copy_constructible_v<T>)
+                return [](const void* src, void* dst, std::size_t count) { if (count != 0) std::memcpy(dst, src, count * sizeof(T)); };
+            else if constexpr (std::is_copy_constructible_v<T>)
+                return [](const void* src, void* dst, std::size_t count) { std::uninitialized_copy_n((const T*)src, count, (T*)dst); };
+            else
+                return nullptr;
+        }
+
+        // src elements are left moved from (not destructed)
+        template<typename T>
+        static MoveConstructNFunction GetMoveConstructN()
+        {
+            if constexpr (std::is_trivially_copyable_v<T> && std::is_move_constructible_v<T>)
+                return [](void* src, void* dst, std::size_t count) { if (count != 0) std::memcpy(dst, src, count * sizeof(T)); };
+            else if constexpr (std::is_move_constructible_v<T>)
+                return [](void* src, void* dst, std::size_t count) { std::uninitialized_move_n((T*)src, count, (T*)dst); };
+            else
+                return nullptr;
+        }
+
+        template<typename T>
+        static void RelocateElement(T* src, T* dst)
+        {
+            new (dst) T(std::move(*src));
+            src->~T();
+        }
+
+        template<typename T>
+        static RelocateFunction GetRelocate()
+        {
+            if constexpr (IsTriviallyRelocatable<T>::value)
+            {
+                return [](void* src, void* dst, std::size_t count) { if (count != 0) std::memmove(dst, src, count * sizeof(T)); };
+            }
+            else if constexpr (std::is_move_constructible_v<T>)
+            {
+                return [](void* src, void* dst, std::size_t count)
+                {
+                    // overlapping ranges: each dst element is free once reached (outside src or already relocated)
+                    if (dst < src)
+                    {
+                        for (std::size_t i = 0; i < count; ++i)
+                            RelocateElement((T*)src + i, (T*)dst + i);
+                    }
+                    else if (dst > src)
+                    {
+                        for (std::size_t i = count; i-- > 0;)
+                            RelocateElement((T*)src + i, (T*)dst + i);
+                    }
+                };
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        template<typename T>
+        static DestructNFunction GetDestructN()
+        {
+            if constexpr (std::is_trivially_destructible_v<T>)
+                return [](void*, std::size_t) {};
+            else
+                return [](void* dst, std::size_t count) { for (std::size_t i = 0; i < count; ++i) ((T*)dst)[i].~T(); };
+        }
     }
 
 #pragma endregion
@@ -561,13 +676,13 @@ namespace eti
         template<typename OBJECT, typename RETURN, typename... ARGS>
         std::span<Variable> GetFunctionArguments(RETURN(OBJECT::* func)(ARGS...) const);
 
-        static Method MakeMethod(std::string_view name, bool isStatic, bool isConst, const Type& parent, std::function<void(void*, void*, std::span<void*>)>&& function, const Variable* _return = nullptr, std::span<const Variable> arguments = {}, std::vector<std::shared_ptr<Attribute>>&& attributes = {}, bool isLambda = false);
+        static Method MakeMethod(std::string_view name, bool isStatic, bool isConst, const Type& parent, MethodFunction function, const Variable* _return = nullptr, std::span<const Variable> arguments = {}, std::span<const std::shared_ptr<Attribute>> attributes = {}, bool isLambda = false);
 
         //
         // Property
 
         template <typename T>
-        static Property MakeProperty(std::string_view name, size_t offset, const Type& parent, std::vector<std::shared_ptr<Attribute>>&& attributes = {});
+        static Property MakeProperty(std::string_view name, size_t offset, const Type& parent, std::span<const std::shared_ptr<Attribute>> attributes = {});
 
         //
         // Type
@@ -577,11 +692,36 @@ namespace eti
             std::span<const Property> properties = {}, 
             std::span<const Method> methods = {}, 
             std::span<Declaration> templates = {}, 
-            std::vector<std::shared_ptr<Attribute>> attributes = {},
-            std::string_view enumNames = {});
+            std::span<const std::shared_ptr<Attribute>> attributes = {},
+            std::string_view enumNames = {},
+            std::span<const EnumEntry> enumEntries = {},
+            bool enumFlags = false);
 
         template <typename... ARGS>
-        std::vector<void*> GetVoidPtrFromArgs(const ARGS&... args);
+        std::array<void*, sizeof...(ARGS)> GetVoidPtrFromArgs(const ARGS&... args);
+
+        template<typename T>
+        std::span<const T> StoreStatic(std::vector<T>&& values);
+
+        //
+        // Lookup
+
+        // slot of open addressing members table, keyed by PropertyId/MethodId
+        template<typename T>
+        struct MemberSlot
+        {
+            TypeId Id = 0;
+            const T* Member = nullptr;
+        };
+
+        template<typename T>
+        std::span<const MemberSlot<T>> MakeMemberTable(std::span<const T> members, std::span<const MemberSlot<T>> parentTable);
+
+        template<typename T>
+        const T* FindMember(std::span<const MemberSlot<T>> table, TypeId id);
+
+        template<typename T>
+        const T* FindMember(std::span<const MemberSlot<T>> table, std::string_view name);
 
         // internal Utils
         // use static const Type& T::GetTypeStatic(){...} if available
@@ -592,7 +732,30 @@ namespace eti
         // Enum
 
         constexpr size_t GetCharCount(std::string_view str, char c);
-        constexpr std::string_view GetEnumNameWithOffset(std::string_view names, size_t index, size_t offset = 0);
+        constexpr size_t GetEnumEntryCount(std::string_view names);
+
+        template<typename TYPE, size_t N>
+        constexpr std::array<EnumEntry, N> MakeEnumEntries(std::string_view names);
+
+        // value to enum entry, dense table (index is value - MinValue) when values range is small,
+        // perfect hash otherwise (index is (value * Multiplier) >> Shift), see FindEnumEntry
+        struct EnumValueLookup
+        {
+            std::span<const EnumEntry* const> Entries;
+            std::size_t MinValue = 0;
+            std::uint64_t Multiplier = 0;
+            std::uint32_t Shift = 0;
+        };
+
+        EnumValueLookup MakeEnumValueLookup(std::span<const EnumEntry> entries);
+        std::span<const EnumEntry* const> MakeEnumBits(std::span<const EnumEntry> entries, size_t bitCount);
+
+        // value bits of underlying type (signed values are sign extended in size_t)
+        constexpr std::uint64_t GetEnumFlagsBits(std::size_t value, size_t bitCount)
+        {
+            return bitCount >= 64 ? (std::uint64_t)value : (std::uint64_t)value & ((1ull << bitCount) - 1);
+        }
+        const EnumEntry* FindEnumEntry(const EnumValueLookup& lookup, std::size_t value);
     }
 
 #pragma endregion
@@ -666,6 +829,31 @@ namespace eti
         Forward     // forward type
     };
 
+    // traits of T captured at instantiation (see Type::Flags), tell type erased code when memcpy/memmove/skip is legal
+    enum class TypeFlags : std::uint8_t
+    {
+        None = 0,
+        TriviallyDestructible = 1 << 0,     // Destruct can be skipped
+        TriviallyCopyable = 1 << 1,         // CopyConstruct/MoveConstruct can be memcpy
+        StandardLayout = 1 << 2,            // std::is_standard_layout
+        PaddingFree = 1 << 3,               // no padding bits, equal objects have equal bytes (can be hashed/compared as bytes)
+        TriviallyRelocatable = 1 << 4       // move + destruct can be memmove (see IsTriviallyRelocatable)
+    };
+
+    constexpr TypeFlags operator|(TypeFlags a, TypeFlags b) { return (TypeFlags)((std::uint8_t)a | (std::uint8_t)b); }
+    constexpr TypeFlags operator&(TypeFlags a, TypeFlags b) { return (TypeFlags)((std::uint8_t)a & (std::uint8_t)b); }
+
+    // move to new address then destruct old one can be done by memmove, trivial move and destruct by default
+    // specialize for types without self reference, ex: template<> struct eti::IsTriviallyRelocatable<Foo> : std::true_type {};
+    template<typename T>
+    struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>> {};
+
+    template<typename T>
+    struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {};
+
+    template<typename T>
+    struct IsTriviallyRelocatable<std::shared_ptr<T>> : std::true_type {};
+
     // return constexpr name for Kind
     static constexpr std::string_view GetKindName(Kind typeDesc)
     {
@@ -712,7 +900,7 @@ namespace eti
         size_t Offset;
         const Type& Parent;
         TypeId PropertyId = 0;
-        std::vector<std::shared_ptr<Attribute>> Attributes;
+        std::span<const std::shared_ptr<Attribute>> Attributes;
 
         template <typename T>
         const T* GetAttribute() const;
@@ -722,6 +910,11 @@ namespace eti
 
         void* UnSafeGetPtr(void* obj) const;
 
+        // batched, property of count objects at objects + i * stride (ex: stride is Type::Size of an array) to/from packed values
+        // property type should be trivially copyable, checked once per call
+        void Gather(const void* objects, size_t stride, size_t count, void* values) const;
+        void Scatter(void* objects, size_t stride, size_t count, const void* values) const;
+
         template <typename OBJECT, typename T>
         void Set(OBJECT& obj, const T& value) const;
 
@@ -737,11 +930,11 @@ namespace eti
         bool IsStatic:1 = false;
         bool IsConst:1 = false;
         bool IsLambda:1 = false;
-        std::function<void(void*, void*, std::span<void*>)> Function;
-        const Variable* Return;
+        MethodFunction Function = nullptr;
+        const Variable* Return = nullptr;
         std::span<const Variable> Arguments;
         const Type* Parent = nullptr;
-        std::vector<std::shared_ptr<Attribute>> Attributes;
+        std::span<const std::shared_ptr<Attribute>> Attributes;
 
         template <typename T>
         const T* GetAttribute() const;
@@ -758,6 +951,22 @@ namespace eti
         void UnSafeCall(void* obj, void* ret, std::span<void*> args) const;
     };
 
+    // enum value name, entries are parsed at compile time from ETI_ENUM declaration
+    struct EnumEntry
+    {
+        std::string_view Name;
+        std::size_t Value = 0;
+    };
+
+    // pool of a type (see Type::NewPooled), slabs are kept until exit and blocks reused
+    struct PoolStats
+    {
+        size_t BlockSize = 0;
+        size_t SlabSize = 0;
+        // slabs allocated so far, never decrease (freed blocks go back to free lists, not slabs)
+        size_t SlabsAllocated = 0;
+    };
+
     // Type, core eti type, represent runtime type information about any T
     struct Type
     {
@@ -767,19 +976,41 @@ namespace eti
         size_t Size = 0;
         size_t Align = 0;
         const Type* Parent = nullptr;
-        std::function<void*()> New;
-        std::function<void(void* /* dst */ )> Delete;
-        std::function<void(void* /* dst */)> Construct;
-        std::function<void(void* /* src */, void* /* dst */)> CopyConstruct;
-        std::function<void(void* /* src */, void* /* dst */)> MoveConstruct;
-        std::function<void(void* /* dst */)> Destruct;
+        // depth in hierarchy and ancestors display (Ancestors[Depth] is this type Id), used by IsA
+        size_t Depth = 0;
+        std::span<const TypeId> Ancestors;
+        // dense index assigned at registration (0, 1, 2...), to keep per type data in flat arrays (see GetTypeIndexCount)
+        size_t Index = InvalidIndex;
+        TypeFlags Flags = TypeFlags::None;
+        NewFunction New = nullptr;
+        DeleteFunction Delete = nullptr;
+        ConstructFunction Construct = nullptr;
+        CopyConstructFunction CopyConstruct = nullptr;
+        MoveConstructFunction MoveConstruct = nullptr;
+        DestructFunction Destruct = nullptr;
+        ConstructNFunction ConstructN = nullptr;
+        CopyConstructNFunction CopyConstructN = nullptr;
+        MoveConstructNFunction MoveConstructN = nullptr;
+        DestructNFunction DestructN = nullptr;
+        RelocateFunction Relocate = nullptr;
 
         std::span<const Property> Properties;
         std::span<const Method> Methods;
+        // own and inherited members, flattened open addressing tables (see GetProperty/GetMethod)
+        std::span<const internal::MemberSlot<Property>> PropertyTable;
+        std::span<const internal::MemberSlot<Method>> MethodTable;
         std::span<Declaration> Templates; // todo: implement!
-        std::vector<std::shared_ptr<Attribute>> Attributes;
+        std::span<const std::shared_ptr<Attribute>> Attributes;
         std::string_view EnumNames;
         size_t EnumSize = 0;
+        // enum entries in declaration order, and by name hash (see GetEnumValue)
+        std::span<const EnumEntry> EnumEntries;
+        std::span<const internal::MemberSlot<EnumEntry>> EnumNameTable;
+        // by value (see GetEnumValueName)
+        internal::EnumValueLookup EnumValueTable;
+        // flags enum (see ETI_ENUM_FLAGS), single bit entries by bit position
+        bool EnumFlags = false;
+        std::span<const EnumEntry* const> EnumBits;
 
         bool operator==(const Type& other) const { return Id == other.Id; }
         bool operator!=(const Type& other) const { return !(*this == other); }
@@ -790,6 +1021,18 @@ namespace eti
         bool HaveCopyConstruct() const { return CopyConstruct != nullptr; }
         bool HaveMove() const { return MoveConstruct != nullptr; }
         bool HaveDestroy() const { return Destruct != nullptr; }
+        bool HaveConstructN() const { return ConstructN != nullptr; }
+        bool HaveCopyConstructN() const { return CopyConstructN != nullptr; }
+        bool HaveMoveN() const { return MoveConstructN != nullptr; }
+        bool HaveDestroyN() const { return DestructN != nullptr; }
+        bool HaveRelocate() const { return Relocate != nullptr; }
+        bool HaveFlag(TypeFlags flag) const { return (Flags & flag) == flag; }
+
+        // like New/Delete but from a per type pool (slabs sized and aligned from Size/Align, thread local free lists)
+        // obj should be deleted with its dynamic type (ex: obj->GetType().DeletePooled(obj)), any thread can delete it
+        void* NewPooled() const;
+        void DeletePooled(void* obj) const;
+        PoolStats GetPoolStats() const;
 
         const Property* GetProperty(std::string_view name) const;
         const Property* GetProperty(TypeId propertyId) const;
@@ -806,8 +1049,18 @@ namespace eti
         std::size_t GetEnumValue(std::string_view enumName) const;
         std::string_view GetEnumValueName(std::size_t enumValue) const;
         TypeId GetEnumValueHash(std::size_t enumValue) const;
+
+        // flags enum, write "A|B|C" in buffer (no allocation), value matching an entry (ex: None = 0, ReadWrite = Read | Write) write its name
+        // return written size, or InvalidIndex if buffer is too small or a bit have no name
+        std::size_t FormatEnumFlags(std::size_t enumValue, std::span<char> buffer) const;
+        // flags enum, parse "A|B|C" (spaces allowed), false if a name is unknown
+        bool ParseEnumFlags(std::string_view str, std::size_t& enumValue) const;
     };
 
+    // metadata are plain data, attributes and members live in static storage
+    static_assert(std::is_trivially_copyable_v<Method>, "Method should be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<Type>, "Type should be trivially copyable");
+
     // default impl of TypeOfImpl::GetTypeStatic(), should be specialized
     // undeclared type (not using ETI_* macro automatically fallback here as Kind::Unknown type
     template<typename T>
@@ -826,6 +1079,216 @@ namespace eti
     template<typename T, typename BASE>
     constexpr bool IsATyped();
 
+    // TypeIndex
+
+    // number of Type::Index assigned so far, per type arrays indexed by Type::Index must grow up to this count
+    size_t GetTypeIndexCount();
+
+    // Arena
+
+    // bump allocator of runtime typed objects (ex: per request scratch objects), everything is released at once by Reset
+    // objects are placed at their type Align, only non trivially destructible ones are recorded to be destructed
+    class Arena
+    {
+    public:
+
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+        explicit Arena(size_t blockSize = DefaultBlockSize) : blockSize(blockSize) {}
+        ~Arena();
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        // uninitialized memory, never destructed
+        void* Allocate(size_t size, size_t align);
+
+        void* Construct(const Type& type);
+        void* CopyConstruct(const Type& type, const void* src);
+
+        template<typename T, typename... ARGS>
+        T* New(ARGS&&... args);
+
+        // destruct objects in reverse order and rewind, blocks are kept for reuse
+        void Reset();
+
+        size_t GetUsedSize() const { return usedSize; }
+        size_t GetCapacity() const;
+        size_t GetDestructCount() const { return destructs.size(); }
+
+    private:
+
+        struct Block
+        {
+            std::byte* Data;
+            size_t Size;
+        };
+
+        struct PendingDestruct
+        {
+            DestructFunction Destruct;
+            void* Object;
+        };
+
+        std::vector<Block> blocks;
+        std::vector<PendingDestruct> destructs;
+        size_t blockIndex = 0;
+        size_t offset = 0;
+        size_t usedSize = 0;
+        size_t blockSize;
+    };
+
+    // DynamicArray
+
+    // member of each element of a contiguous array, checked once then plain offset and stride
+    template<typename T>
+    struct MemberView
+    {
+        std::byte* Data = nullptr;
+        size_t Stride = 0;
+        size_t Size = 0;
+
+        T& operator[](size_t index) const { return *reinterpret_cast<T*>(Data + index * Stride); }
+        size_t GetSize() const { return Size; }
+    };
+
+    // contiguous array of a runtime type (ex: components known by TypeId only), stride is Type::Size
+    // elements lifecycle use Type array operations (ConstructN, CopyConstructN, DestructN, Relocate)
+    class DynamicArray
+    {
+    public:
+
+        explicit DynamicArray(const Type& type);
+        DynamicArray(const DynamicArray& other);
+        DynamicArray(DynamicArray&& other) noexcept;
+        DynamicArray& operator=(const DynamicArray& other);
+        DynamicArray& operator=(DynamicArray&& other) noexcept;
+        ~DynamicArray();
+
+        const Type& GetType() const { return *type; }
+        size_t GetSize() const { return size; }
+        size_t GetCapacity() const { return capacity; }
+        size_t GetStride() const { return type->Size; }
+        bool IsEmpty() const { return size == 0; }
+
+        void* GetData() { return data; }
+        const void* GetData() const { return data; }
+        void* Get(size_t index);
+        const void* Get(size_t index) const;
+
+        void Reserve(size_t newCapacity);
+        // new elements are default constructed
+        void Resize(size_t newSize);
+        void Clear();
+
+        // default constructed or copy of value, return new element
+        void* PushBack();
+        void* PushBack(const void* value);
+        void PopBack();
+
+        // count default constructed elements at index, return first one
+        void* Insert(size_t index, size_t count = 1);
+        // copies of count values at index (values should not be in this array), return first one
+        void* Insert(size_t index, const void* values, size_t count);
+        void Erase(size_t index, size_t count = 1);
+
+        // T should be the array type
+        template<typename T>
+        std::span<T> AsSpan();
+        template<typename T>
+        std::span<const T> AsSpan() const;
+
+        // property of array type (or of a parent), ex: for (size_t i...) sum += x[i]; with x = array.GetMembers<float>(*property)
+        void* GetMember(size_t index, const Property& property);
+        template<typename T>
+        MemberView<T> GetMembers(const Property& property);
+
+    private:
+
+        // count elements at index built by construct(first), on throw array is left unchanged (construct should leave nothing constructed)
+        template<typename CONSTRUCT>
+        std::byte* InsertConstructed(size_t index, size_t count, CONSTRUCT&& construct);
+        void Reallocate(size_t newCapacity);
+        void Release();
+
+        const Type* type;
+        std::byte* data = nullptr;
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+
+    // SoAVector
+
+    // structure of arrays of T, one column per property of T (parent properties first), for loops touching few members
+    // columns are aligned on ColumnAlign (ex: AVX kernels stream them directly), members not reflected are not stored
+    template<typename T>
+    class SoAVector
+    {
+    public:
+
+        static constexpr size_t ColumnAlign = 64;
+
+        struct Column
+        {
+            const Property* Property = nullptr;
+            // nullptr for pointer property
+            const Type* Type = nullptr;
+            size_t Size = 0;
+            // memcpy/memmove, no destruct (trivially copyable or pointer)
+            bool Trivial = false;
+            std::byte* Data = nullptr;
+        };
+
+        SoAVector();
+        explicit SoAVector(const std::vector<T>& values);
+        SoAVector(const SoAVector& other);
+        SoAVector(SoAVector&& other) noexcept;
+        SoAVector& operator=(const SoAVector& other);
+        SoAVector& operator=(SoAVector&& other) noexcept;
+        ~SoAVector();
+
+        size_t GetSize() const { return size; }
+        size_t GetCapacity() const { return capacity; }
+        bool IsEmpty() const { return size == 0; }
+
+        void Reserve(size_t newCapacity);
+        void Clear();
+        void PushBack(const T& value);
+        void PopBack();
+        void Erase(size_t index, size_t count = 1);
+
+        // element gathered from columns, members not reflected keep their default value
+        T Get(size_t index) const;
+        void Set(size_t index, const T& value);
+        std::vector<T> ToVector() const;
+
+        // Data is nullptr until first allocation
+        std::span<const Column> GetColumns() const { return columns.empty() ? GetLayout() : std::span<const Column>(columns); }
+        // nullptr if T have no such property
+        const Column* FindColumn(TypeId propertyId) const;
+
+        // U should be property type, ex: std::span<float> x = particles.GetColumn<float>(TypeOf<Particle>().GetProperty("X")->PropertyId);
+        template<typename U>
+        std::span<U> GetColumn(TypeId propertyId);
+        template<typename U>
+        std::span<const U> GetColumn(TypeId propertyId) const;
+
+    private:
+
+        // columns of T without storage, instance columns are copied from it on first allocation (no allocation before)
+        static const std::vector<Column>& GetLayout();
+        static void AppendColumns(std::vector<Column>& columns, const Type& type);
+        // element range of non trivial columns before columnCount, used to undo partial construction
+        void DestructColumns(size_t columnCount, size_t first, size_t count);
+        // replace constructed dst by a copy of src, dst is untouched if the copy throw
+        static void CopyReplace(const Type& type, const std::byte* src, std::byte* dst);
+        void Reallocate(size_t newCapacity);
+        void Release();
+
+        std::vector<Column> columns;
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+
     // Cast
 
     template<typename BASE, typename T>
@@ -834,6 +1297,41 @@ namespace eti
     template<typename BASE, typename T>
     const BASE* Cast(const T* instance);
 
+    // TypeId collisions
+
+    // compile time check of a list of types, ex: static_assert(eti::HaveUniqueTypeIds<Foo, Doo, Goo>());
+    template<typename... T>
+    constexpr bool HaveUniqueTypeIds()
+    {
+        if constexpr (sizeof...(T) < 2)
+        {
+            return true;
+        }
+        else
+        {
+            constexpr TypeId ids[] = { GetTypeId<T>()... };
+            constexpr std::string_view names[] = { GetTypeName<T>()... };
+            for (size_t i = 0; i < sizeof...(T); ++i)
+            {
+                for (size_t j = i + 1; j < sizeof...(T); ++j)
+                {
+                    if (ids[i] == ids[j] && names[i] != names[j])
+                        return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    // same id for different names, Owner is nullptr for types, else the type of colliding properties, methods or enum values
+    struct IdCollision
+    {
+        TypeId Id = 0;
+        std::string_view First;
+        std::string_view Second;
+        const Type* Owner = nullptr;
+    };
+
     #if ETI_REPOSITORY
     class Repository
     {
@@ -842,35 +1340,45 @@ namespace eti
 
         static Repository& Instance();
 
-        void Register(const Type& type)
-        {
-            ETI_ASSERT(idToTypes.find(type.Id) == idToTypes.end(), "Type already registered to duplicate TypeId");
-            ETI_ASSERT(namesToTypes.find(type.Name) == namesToTypes.end(), "Type already registered to duplicate TypeId");
+        // all types self register once initialized (see internal::FinalizeTypes)
+        void Register(const Type& type);
 
-            idToTypes[type.Id] = &type;
-            namesToTypes[type.Name] = &type;
-        }
+        const Type* GetType(TypeId id) const;
+        const Type* GetType(std::string_view name) const;
+        // by Type::Index, nullptr if not registered yet
+        const Type* GetTypeByIndex(size_t index) const;
 
-        const Type* GetType(TypeId id) const
-        {
-            auto it = idToTypes.find(id);
-            if (it != idToTypes.end())
-                return it->second;
-            return nullptr;
-        }
+        // bulk check of registered types ids, and ids of their properties, methods and enum values
+        // Register only keep first type of an id, colliding ones are still reachable by index
+        std::vector<IdCollision> AuditCollisions() const;
+        size_t GetTypeCount() const { return count.load(std::memory_order_relaxed); }
 
-        const Type* GetType(std::string_view name) const
+    private:
+
+        // open addressing table of types, capacity is power of 2 with load factor <= 0.5
+        // lookups never lock: a full table is replaced by a bigger one, previous tables stay alive
+        struct Table
         {
-            auto it = namesToTypes.find(name);
-            if (it != namesToTypes.end())
-                return it->second;
-            return nullptr;
-        }
+            explicit Table(size_t capacity) : Mask(capacity - 1), Slots(capacity) {}
 
-    private:
+            size_t Mask;
+            std::vector<std::atomic<const Type*>> Slots;
+        };
+
+        static void Insert(Table& table, TypeId key, const Type* type);
+        void Grow();
+
+        // types by Type::Index in fixed size chunks, allocated once and never moved (lookups never lock)
+        static constexpr size_t IndexChunkSize = 1024;
+        static constexpr size_t IndexChunkCount = 1024;
+        using IndexChunk = std::array<std::atomic<const Type*>, IndexChunkSize>;
+        std::array<std::atomic<IndexChunk*>, IndexChunkCount> indices = {};
+        std::vector<std::unique_ptr<IndexChunk>> indexChunks;
 
-        std::map<TypeId, const Type*> idToTypes;
-        std::map<std::string_view, const Type*> namesToTypes;
+        std::atomic<const Table*> ids = nullptr;
+        std::atomic<const Table*> names = nullptr;
+        std::vector<std::unique_ptr<Table>> tables;
+        std::atomic<size_t> count = 0;
     };
 
 #define ETI_REPOSITORY_IMPL() \
@@ -889,12 +1397,17 @@ namespace eti
 
 #endif // #if ETI_REPOSITORY
 
-
-
 #pragma endregion
 
 }
 
+// TypeId128 in hashed containers
+template<>
+struct std::hash<eti::TypeId128>
+{
+    size_t operator()(const eti::TypeId128& id) const noexcept { return (size_t)(id.Low ^ id.High); }
+};
+
 #pragma region Macros
 
 // don't use offsetof since it produce warning with clang
@@ -933,10 +1446,10 @@ namespace eti
         ::eti::TypeOf<Self>(), \
         [](void* obj, void* _return, std::span<void*> args) \
         { \
-            ::eti::utils::CallStaticLambda(std::function(LAMBDA), obj, _return, args); \
+            ::eti::utils::CallStaticLambda(+(LAMBDA), obj, _return, args); \
         }, \
-        ::eti::internal::GetFunctionReturn(std::function(LAMBDA)), \
-        ::eti::internal::GetFunctionArguments( std::function(LAMBDA)), \
+        ::eti::internal::GetFunctionReturn(+(LAMBDA)), \
+        ::eti::internal::GetFunctionArguments(+(LAMBDA)), \
         ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__), true)
 
 #define ETI_METHOD_STATIC_LAMBDA(NAME, LAMBDA, ...) \
@@ -946,10 +1459,10 @@ namespace eti
         ::eti::TypeOf<Self>(), \
         [](void* obj, void* _return, std::span<void*> args) \
         { \
-            ::eti::utils::CallStaticLambda(std::function(LAMBDA), obj, _return, args); \
+            ::eti::utils::CallStaticLambda(+(LAMBDA), obj, _return, args); \
         }, \
-        ::eti::internal::GetFunctionReturn(std::function(LAMBDA)), \
-        ::eti::internal::GetFunctionArguments( std::function(LAMBDA)), \
+        ::eti::internal::GetFunctionReturn(+(LAMBDA)), \
+        ::eti::internal::GetFunctionArguments(+(LAMBDA)), \
         ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__))
 
 #define ETI_METHOD_OVERLOAD(NAME, METHOD_TYPE, ...) \
@@ -1009,14 +1522,11 @@ namespace eti
     static constexpr ::eti::TypeId TypeId = ::eti::GetTypeId<TYPE>();\
     static const ::eti::Type& GetTypeStatic()  \
     {  \
-        static bool initializing = false; \
-        static ::eti::Type type; \
-        if (initializing == false) \
+        static constinit ::eti::internal::TypeStorage storage; \
+        return ::eti::internal::GetOrInitializeType(storage, []() \
         { \
-            initializing = true; \
-            type = ::eti::internal::template MakeType<TYPE>(KIND, PARENT, TYPE::GetProperties(), TYPE::GetMethods(), {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-        } \
-        return type; \
+            return ::eti::internal::template MakeType<TYPE>(KIND, PARENT, TYPE::GetProperties(), TYPE::GetMethods(), {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+        }); \
     }
 
 #define ETI_INTERNAL_TYPE_IMPL(TYPE, KIND, PARENT, PROPERTIES, METHODS, TEMPLATES, ATTRIBUTES) \
@@ -1027,8 +1537,11 @@ namespace eti
         { \
             static const ::eti::Type& GetTypeStatic() \
             { \
-                static ::eti::Type type = ::eti::internal::MakeType<TYPE>(KIND, PARENT, PROPERTIES, METHODS, TEMPLATES, ATTRIBUTES); \
-                return type; \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
+                { \
+                    return ::eti::internal::MakeType<TYPE>(KIND, PARENT, PROPERTIES, METHODS, TEMPLATES, ATTRIBUTES); \
+                }); \
             } \
         }; \
     }
@@ -1042,16 +1555,13 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = TYPE; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
                     static std::vector<::eti::Property> properties = { PROPERTIES }; \
                     static std::vector<::eti::Method> methods =  { METHODS  }; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Struct, nullptr, properties, methods, {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-                } \
-                return type; \
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Struct, nullptr, properties, methods, {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+                }); \
             } \
         }; \
     }
@@ -1065,16 +1575,13 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = TYPE; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
                     static std::vector<::eti::Property> properties = { PROPERTIES }; \
                     static std::vector<::eti::Method> methods =  { METHODS  }; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Class, nullptr, properties, methods, {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-                } \
-                return type; \
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Class, nullptr, properties, methods, {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+                }); \
             } \
         }; \
     }
@@ -1088,16 +1595,13 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = TYPE; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
                     static std::vector<::eti::Property> properties = { PROPERTIES }; \
                     static std::vector<::eti::Method> methods =  { METHODS  }; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Class, &::eti::TypeOf<BASE>(), properties, methods, {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-                } \
-                return type; \
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Class, &::eti::TypeOf<BASE>(), properties, methods, {}, ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+                }); \
             } \
         }; \
     }
@@ -1124,7 +1628,7 @@ namespace eti
 
 #define ETI_INTERNAL_ENUM_ARGS_STRING(...) #__VA_ARGS__
 
-#define ETI_INTERNAL_ENUM_ARGS_SIZE(...)  (::eti::internal::GetCharCount(::std::string_view(ETI_INTERNAL_ENUM_ARGS_STRING(__VA_ARGS__)), ',') + 1)
+#define ETI_INTERNAL_ENUM_ARGS_SIZE(...)  (::eti::internal::GetEnumEntryCount(::std::string_view(ETI_INTERNAL_ENUM_ARGS_STRING(__VA_ARGS__))))
 
 #define ETI_ENUM(TYPE, ENUM, ...) \
     enum class ENUM : TYPE \
@@ -1134,7 +1638,17 @@ namespace eti
     static constexpr std::string_view ENUM##Names = ETI_INTERNAL_ENUM_ARGS_STRING(__VA_ARGS__);
 
 
+// flags enum, values are bit masks (ex: Read = 1 << 0, Write = 1 << 1, ReadWrite = Read | Write)
+#define ETI_ENUM_FLAGS(TYPE, ENUM, ...) \
+    ETI_ENUM(TYPE, ENUM, __VA_ARGS__)
+
 #define ETI_ENUM_IMPL(ENUM) \
+    ETI_INTERNAL_ENUM_IMPL(ENUM, false)
+
+#define ETI_ENUM_FLAGS_IMPL(ENUM) \
+    ETI_INTERNAL_ENUM_IMPL(ENUM, true)
+
+#define ETI_INTERNAL_ENUM_IMPL(ENUM, FLAGS) \
     namespace eti \
     { \
         template <> \
@@ -1143,14 +1657,12 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = ENUM; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                static constexpr auto entries = ::eti::internal::MakeEnumEntries<std::underlying_type_t<Self>, ::eti::internal::GetEnumEntryCount(ENUM##Names)>(ENUM##Names); \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Enum, &::eti::TypeOf<std::underlying_type_t<Self>>(), {}, {}, {}, {}, ENUM##Names); \
-                } \
-                return type;\
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Enum, &::eti::TypeOf<std::underlying_type_t<Self>>(), {}, {}, {}, {}, ENUM##Names, entries, FLAGS); \
+                }); \
             } \
         }; \
     }
@@ -1165,16 +1677,13 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = TYPE<T1>; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
                     static std::vector<::eti::Property> properties = { PROPERTIES }; \
                     static std::vector<::eti::Method> methods =  { METHODS  }; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Class, nullptr, properties, methods, ::eti::internal::MakeDeclarations<T1>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-                } \
-                return type; \
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Class, nullptr, properties, methods, ::eti::internal::MakeDeclarations<T1>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+                }); \
             } \
         }; \
     }
@@ -1188,16 +1697,13 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = TYPE<T1>; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
                     static std::vector<::eti::Property> properties = { PROPERTIES }; \
                     static std::vector<::eti::Method> methods =  { METHODS  }; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Class, &::eti::TypeOf<BASE>(), properties, methods, ::eti::internal::MakeDeclarations<T1>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-                } \
-                return type; \
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Class, &::eti::TypeOf<BASE>(), properties, methods, ::eti::internal::MakeDeclarations<T1>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+                }); \
             } \
         }; \
     }
@@ -1211,16 +1717,13 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = TYPE<T1,T2>; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
                     static std::vector<::eti::Property> properties = { PROPERTIES }; \
                     static std::vector<::eti::Method> methods =  { METHODS  }; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Class, nullptr, properties, methods, ::eti::internal::MakeDeclarations<T1,T2>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-                } \
-                return type; \
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Class, nullptr, properties, methods, ::eti::internal::MakeDeclarations<T1,T2>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+                }); \
             } \
         }; \
     }
@@ -1234,16 +1737,13 @@ namespace eti
             static const ::eti::Type& GetTypeStatic() \
             { \
                 using Self = TYPE<T1,T2>; \
-                static bool initializing = false; \
-                static ::eti::Type type; \
-                if (initializing == false) \
+                static constinit ::eti::internal::TypeStorage storage; \
+                return ::eti::internal::GetOrInitializeType(storage, []() \
                 { \
-                    initializing = true; \
                     static std::vector<::eti::Property> properties = { PROPERTIES }; \
                     static std::vector<::eti::Method> methods =  { METHODS  }; \
-                    type = ::eti::internal::MakeType<Self>(::eti::Kind::Class, &::eti::TypeOf<BASE>(), properties, methods, ::eti::internal::MakeDeclarations<T1,T2>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
-                } \
-                return type; \
+                    return ::eti::internal::MakeType<Self>(::eti::Kind::Class, &::eti::TypeOf<BASE>(), properties, methods, ::eti::internal::MakeDeclarations<T1,T2>(), ::eti::internal::GetAttributes<::eti::Attribute>(__VA_ARGS__)); \
+                }); \
             } \
         }; \
     }
@@ -1327,12 +1827,6 @@ namespace eti
             return internal::GetVariable<RETURN>("");
         }
 
-        template<typename RETURN, typename... ARGS>
-        const Variable* GetFunctionReturn( std::function<RETURN(ARGS...)> )
-        {
-            return internal::GetVariable<RETURN>("");
-        }
-
 
         template<typename RETURN, typename... ARGS>
         std::span<Variable> GetFunctionArguments(RETURN(*)(ARGS...))
@@ -1352,17 +1846,11 @@ namespace eti
             return internal::GetVariables<ARGS...>();
         }
 
-        template<typename RETURN, typename... ARGS>
-        std::span<Variable> GetFunctionArguments( std::function<RETURN(ARGS...)> )
-        {
-            return internal::GetVariables<ARGS...>();
-        }
-
         //
         // Property
 
         template <typename T>
-        Property MakeProperty(std::string_view name, size_t offset, const Type& parent, std::vector<std::shared_ptr<Attribute>>&& attributes /*= {}*/)
+        Property MakeProperty(std::string_view name, size_t offset, const Type& parent, std::span<const std::shared_ptr<Attribute>> attributes /*= {}*/)
         {
             ETI_ASSERT(!std::is_reference<T>(), "reference not supported for property, (offsetof return always 0)");
 
@@ -1372,14 +1860,14 @@ namespace eti
                 offset,
                 parent,
                 utils::GetStringHash(name),
-                std::move(attributes)
+                attributes
             };
         }
 
         //
         // Method
 
-        inline Method MakeMethod(std::string_view name, bool isStatic, bool isConst, const Type& parent, std::function<void(void*, void*, std::span<void*>)>&& function, const Variable* _return /*= nullptr*/, std::span<const Variable> arguments /*= {}*/, std::vector<std::shared_ptr<Attribute>>&& attributes /*= {}*/, bool isLambda /*= false*/)
+        inline Method MakeMethod(std::string_view name, bool isStatic, bool isConst, const Type& parent, MethodFunction function, const Variable* _return /*= nullptr*/, std::span<const Variable> arguments /*= {}*/, std::span<const std::shared_ptr<Attribute>> attributes /*= {}*/, bool isLambda /*= false*/)
         {
             return
             {
@@ -1396,13 +1884,32 @@ namespace eti
             };
         }
 
+        template<typename T>
+        constexpr TypeFlags GetTypeFlags()
+        {
+            TypeFlags flags = TypeFlags::None;
+            if constexpr (std::is_trivially_destructible_v<T>)
+                flags = flags | TypeFlags::TriviallyDestructible;
+            if constexpr (std::is_trivially_copyable_v<T>)
+                flags = flags | TypeFlags::TriviallyCopyable;
+            if constexpr (std::is_standard_layout_v<T>)
+                flags = flags | TypeFlags::StandardLayout;
+            if constexpr (std::has_unique_object_representations_v<T>)
+                flags = flags | TypeFlags::PaddingFree;
+            if constexpr (IsTriviallyRelocatable<T>::value)
+                flags = flags | TypeFlags::TriviallyRelocatable;
+            return flags;
+        }
+
         template<typename T>
         static Type MakeType(::eti::Kind kind, const Type* parent, 
             std::span<const Property> properties /*= {}*/, 
             std::span<const Method> methods /*= {}*/, 
             std::span<Declaration> templates /*= {}*/, 
-            std::vector<std::shared_ptr<Attribute>> attributes /*= {}*/,
-            std::string_view enumNames /*= {}*/)
+            std::span<const std::shared_ptr<Attribute>> attributes /*= {}*/,
+            std::string_view enumNames /*= {}*/,
+            std::span<const EnumEntry> enumEntries /*= {}*/,
+            bool enumFlags /*= false*/)
         {
             if constexpr (std::is_void<T>::value == false)
             {
@@ -1416,18 +1923,34 @@ namespace eti
                         sizeof(T),
                         alignof(T),
                         parent,
+                        0,
+                        {},
+                        InvalidIndex,
+                        GetTypeFlags<T>(),
                         utils::GetNew<T>(),
                         utils::GetDelete<T>(),
                         utils::GetConstruct<T>(),
                         utils::GetCopyConstruct<T>(),
                         utils::GetMoveConstruct<T>(),
                         utils::GetDestruct<T>(),
+                        utils::GetConstructN<T>(),
+                        utils::GetCopyConstructN<T>(),
+                        utils::GetMoveConstructN<T>(),
+                        utils::GetDestructN<T>(),
+                        utils::GetRelocate<T>(),
                         properties,
                         methods,
+                        {},
+                        {},
                         templates,
                         attributes,
                         enumNames,
-                        internal::GetCharCount(enumNames, ',') + 1
+                        enumEntries.size(),
+                        enumEntries,
+                        {},
+                        {},
+                        enumFlags,
+                        {}
                     };
                 }
                 else
@@ -1440,18 +1963,34 @@ namespace eti
                         0,
                         0,
                         nullptr,
+                        0,
+                        {},
+                        InvalidIndex,
+                        TypeFlags::None,
+                        nullptr,
+                        nullptr,
+                        nullptr,
+                        nullptr,
                         nullptr,
                         nullptr,
                         nullptr,
                         nullptr,
                         nullptr,
                         nullptr,
+                        nullptr,
+                        {},
+                        {},
+                        {},
                         {},
                         {},
                         {},
                         {},
+                        0,
+                        {},
                         {},
-                        0
+                        {},
+                        false,
+                        {}
                     };
                 }
             }
@@ -1465,25 +2004,43 @@ namespace eti
                     0,
                     0,
                     nullptr,
+                    0,
+                    {},
+                    InvalidIndex,
+                    TypeFlags::None,
+                    nullptr,
+                    nullptr,
+                    nullptr,
                     nullptr,
                     nullptr,
                     nullptr,
                     nullptr,
                     nullptr,
                     nullptr,
+                    nullptr,
+                    nullptr,
+                    {},
+                    {},
                     {},
                     {},
                     {},
                     {},
                     {},
-                    0
+                    0,
+                    {},
+                    {},
+                    {},
+                    false,
+                    {}
                 };
             }
         }
 
+        // pack args ptr on the stack, no allocation
         template <typename... ARGS>
-        std::vector<void*> GetVoidPtrFromArgs(const ARGS&... args)
+        std::array<void*, sizeof...(ARGS)> GetVoidPtrFromArgs(const ARGS&... args)
         {
+            static_assert(sizeof...(ARGS) <= ETI_METHOD_ARGUMENTS_MAX, "too many arguments, see ETI_METHOD_ARGUMENTS_MAX");
             return { ((void*)&args)... };
         }
 
@@ -1497,10 +2054,247 @@ namespace eti
                 return TypeOfImpl<RawType>::GetTypeStatic();
         }
 
+        // keep values alive for the program lifetime, metadata (Type, Property, Method) only reference them by span
+        // note: only called while types are initialized (under types mutex)
+        template<typename T>
+        std::span<const T> StoreStatic(std::vector<T>&& values)
+        {
+            if (values.empty())
+                return {};
+            static std::deque<std::vector<T>> storage;
+            return storage.emplace_back(std::move(values));
+        }
+
         template<typename T, typename... ARGS>
-        static std::vector<std::shared_ptr<T>> GetAttributes(ARGS... args)
+        static std::span<const std::shared_ptr<T>> GetAttributes(ARGS... args)
+        {
+            return StoreStatic(std::vector<std::shared_ptr<T>>{ std::make_shared<ARGS>(args)... });
+        }
+
+        //
+        // Lookup
+
+        inline TypeId GetMemberId(const Property& property) { return property.PropertyId; }
+        inline TypeId GetMemberId(const Method& method) { return method.MethodId; }
+        inline std::string_view GetMemberName(const Property& property) { return property.Variable.Name; }
+        inline std::string_view GetMemberName(const Method& method) { return method.Name; }
+        inline TypeId GetMemberId(const EnumEntry& entry) { return utils::GetStringHash(entry.Name); }
+        inline std::string_view GetMemberName(const EnumEntry& entry) { return entry.Name; }
+
+        constexpr size_t GetSlotIndex(TypeId id, size_t mask)
+        {
+            std::uint64_t bits = utils::GetIdBits(id);
+            return (size_t)(bits ^ (bits >> 32)) & mask;
+        }
+
+        // flatten own members then inherited ones (own members hide inherited ones with same name)
+        // capacity is power of 2 with load factor <= 0.5, so probing always end on an empty slot
+        template<typename T>
+        std::span<const MemberSlot<T>> MakeMemberTable(std::span<const T> members, std::span<const MemberSlot<T>> parentTable)
+        {
+            size_t count = members.size() + std::ranges::count_if(parentTable, [](const MemberSlot<T>& slot) { return slot.Member != nullptr; });
+            if (count == 0)
+                return {};
+
+            size_t capacity = 1;
+            while (capacity < count * 2)
+                capacity <<= 1;
+            size_t mask = capacity - 1;
+
+            std::vector<MemberSlot<T>> table(capacity);
+            auto insert = [&table, mask](TypeId id, const T* member)
+            {
+                size_t index = GetSlotIndex(id, mask);
+                while (table[index].Member != nullptr)
+                {
+                    if (table[index].Id == id && GetMemberName(*table[index].Member) == GetMemberName(*member))
+                        return;
+                    index = (index + 1) & mask;
+                }
+                table[index] = { id, member };
+            };
+
+            for (const T& member : members)
+                insert(GetMemberId(member), &member);
+
+            for (const MemberSlot<T>& slot : parentTable)
+            {
+                if (slot.Member != nullptr)
+                    insert(slot.Id, slot.Member);
+            }
+
+            return StoreStatic(std::move(table));
+        }
+
+        template<typename T>
+        const T* FindMember(std::span<const MemberSlot<T>> table, TypeId id)
+        {
+            if (table.empty())
+                return nullptr;
+            size_t mask = table.size() - 1;
+            for (size_t index = GetSlotIndex(id, mask); table[index].Member != nullptr; index = (index + 1) & mask)
+            {
+                if (table[index].Id == id)
+                    return table[index].Member;
+            }
+            return nullptr;
+        }
+
+        template<typename T>
+        const T* FindMember(std::span<const MemberSlot<T>> table, std::string_view name)
+        {
+            if (table.empty())
+                return nullptr;
+            TypeId id = utils::GetStringHash(name);
+            size_t mask = table.size() - 1;
+            for (size_t index = GetSlotIndex(id, mask); table[index].Member != nullptr; index = (index + 1) & mask)
+            {
+                if (table[index].Id == id && GetMemberName(*table[index].Member) == name)
+                    return table[index].Member;
+            }
+            return nullptr;
+        }
+
+        //
+        // Type initialization
+
+        enum class TypeState : std::uint8_t
+        {
+            Uninitialized,
+            Initializing,
+            Ready
+        };
+
+        // static storage of each type (see GetTypeStatic in ETI_* macros), constant initialized so no static guard
+        // Value is only read by other threads once State is Ready
+        struct TypeStorage
+        {
+            std::atomic<TypeState> State{ TypeState::Uninitialized };
+            Type Value;
+        };
+
+        // first time initialization of all types is serialized, recursive since a type initialize its dependent types
+        inline std::recursive_mutex& GetTypesMutex()
+        {
+            static std::recursive_mutex mutex;
+            return mutex;
+        }
+
+        inline std::atomic<size_t>& GetTypeIndexCounter()
+        {
+            static std::atomic<size_t> counter = 0;
+            return counter;
+        }
+
+        // types initialized but not finalized yet, finalization is done once outermost type initialization is done
+        // since types declared cyclically (ex: property Foo* in Foo parent) are initialized before their parent
+        struct PendingTypes
+        {
+            size_t Depth = 0;
+            std::vector<TypeStorage*> Types;
+        };
+
+        inline PendingTypes& GetPendingTypes()
+        {
+            static PendingTypes pendingTypes;
+            return pendingTypes;
+        }
+
+        // parent is completely initialized and finalized at this point
+        inline void FinalizeType(Type& type)
+        {
+            std::vector<TypeId> ancestors;
+            if (type.Parent != nullptr)
+                ancestors.assign(type.Parent->Ancestors.begin(), type.Parent->Ancestors.end());
+            ancestors.push_back(type.Id);
+            type.Depth = ancestors.size() - 1;
+            type.Ancestors = StoreStatic(std::move(ancestors));
+
+            // forward types are replaced by complete ones, no index
+            if (type.Kind != Kind::Forward)
+                type.Index = GetTypeIndexCounter().fetch_add(1, std::memory_order_relaxed);
+
+            type.PropertyTable = MakeMemberTable(type.Properties, type.Parent != nullptr ? type.Parent->PropertyTable : std::span<const MemberSlot<Property>>());
+            type.MethodTable = MakeMemberTable(type.Methods, type.Parent != nullptr ? type.Parent->MethodTable : std::span<const MemberSlot<Method>>());
+            type.EnumNameTable = MakeMemberTable(type.EnumEntries, {});
+            type.EnumValueTable = MakeEnumValueLookup(type.EnumEntries);
+            if (type.EnumFlags)
+                type.EnumBits = MakeEnumBits(type.EnumEntries, type.Size * 8);
+        }
+
+        // types are published (Ready) only once all of them are finalized, since they reference each other
+        inline void FinalizeTypes(std::vector<TypeStorage*>& types)
+        {
+            std::vector<TypeStorage*> pending = types;
+            while (!pending.empty())
+            {
+                // parent first
+                auto it = std::ranges::find_if(pending, [&pending](const TypeStorage* storage)
+                {
+                    return std::ranges::find_if(pending, [storage](const TypeStorage* other) { return &other->Value == storage->Value.Parent; }) == pending.end();
+                });
+                ETI_INTERNAL_ASSERT(it != pending.end(), "cyclic parent declaration");
+                FinalizeType((*it)->Value);
+                pending.erase(it);
+            }
+
+            #if ETI_REPOSITORY
+            for (TypeStorage* storage : types)
+                Repository::Instance().Register(storage->Value);
+            #endif
+
+            for (TypeStorage* storage : types)
+                storage->State.store(TypeState::Ready, std::memory_order_release);
+            types.clear();
+        }
+
+        // scope of type initialization (see InitializeType)
+        class InitializeTypeScope
+        {
+        public:
+
+            InitializeTypeScope(TypeStorage& storage)
+                : storage(storage)
+            {
+                ++GetPendingTypes().Depth;
+            }
+
+            ~InitializeTypeScope()
+            {
+                PendingTypes& pendingTypes = GetPendingTypes();
+                pendingTypes.Types.push_back(&storage);
+                if (--pendingTypes.Depth == 0)
+                    FinalizeTypes(pendingTypes.Types);
+            }
+
+        private:
+
+            TypeStorage& storage;
+        };
+
+        // slow path, first call (from any thread) initialize the type under types mutex
+        template<typename MAKE_TYPE>
+        const Type& InitializeType(TypeStorage& storage, MAKE_TYPE makeType)
+        {
+            std::lock_guard<std::recursive_mutex> lock(GetTypesMutex());
+
+            // already initialized by another thread, or re-entrant call while initializing (ex: property Foo* in Foo) get partial type
+            if (storage.State.load(std::memory_order_relaxed) != TypeState::Uninitialized)
+                return storage.Value;
+
+            storage.State.store(TypeState::Initializing, std::memory_order_relaxed);
+            InitializeTypeScope scope(storage);
+            storage.Value = makeType();
+            return storage.Value;
+        }
+
+        // fast path, once initialized, only an acquire load
+        template<typename MAKE_TYPE>
+        const Type& GetOrInitializeType(TypeStorage& storage, MAKE_TYPE makeType)
         {
-            return { std::make_shared<ARGS>(args)... };
+            if (storage.State.load(std::memory_order_acquire) == TypeState::Ready) [[likely]]
+                return storage.Value;
+            return InitializeType(storage, makeType);
         }
 
         //
@@ -1508,290 +2302,1731 @@ namespace eti
 
         constexpr size_t GetCharCount( std::string_view str, char c )
         {
-            size_t count = 0;
-            for (size_t i = 0; i < str.size(); ++i)
+            size_t count = 0;
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                if (str[i] == c)
+                    count++;
+            }
+            return count;    
+        }
+
+        constexpr std::string_view TrimSpaces(std::string_view str)
+        {
+            size_t first = str.find_first_not_of(' ');
+            if (first == std::string_view::npos)
+                return {};
+            size_t last = str.find_last_not_of(' ');
+            return str.substr(first, last - first + 1);
+        }
+
+        constexpr bool IsIdentifierChar(char c)
+        {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        }
+
+        // end of enum value declaration starting at offset, skip ',' in parenthesis and char literal
+        constexpr size_t FindEnumEntryEnd(std::string_view names, size_t offset)
+        {
+            size_t depth = 0;
+            for (size_t i = offset; i < names.size(); ++i)
+            {
+                char c = names[i];
+                // not a digit separator (1'000)
+                if (c == '\'' && (i == 0 || !IsIdentifierChar(names[i - 1])))
+                    i = names.find('\'', i + (names[i + 1] == '\\' ? 3 : 2));
+                else if (c == '(')
+                    ++depth;
+                else if (c == ')')
+                    --depth;
+                else if (c == ',' && depth == 0)
+                    return i;
+            }
+            return names.size();
+        }
+
+        // trailing ',' is allowed
+        constexpr size_t GetEnumEntryCount(std::string_view names)
+        {
+            size_t count = 0;
+            for (size_t offset = 0; offset < names.size(); offset = FindEnumEntryEnd(names, offset) + 1)
+            {
+                if (!TrimSpaces(names.substr(offset, FindEnumEntryEnd(names, offset) - offset)).empty())
+                    ++count;
+            }
+            return count;
+        }
+
+        // constant expression of an explicit enum value ("0x8001", "1 << 3", "Read | Write", 'a'...)
+        // names refer to previous entries, values are computed as std::uint64_t (negative values wrap like size_t casts)
+        class EnumValueParser
+        {
+        public:
+
+            constexpr EnumValueParser(std::string_view str, std::span<const EnumEntry> previous)
+                : str(str), previous(previous) {}
+
+            constexpr std::uint64_t Parse()
+            {
+                std::uint64_t value = ParseBinary(0);
+                SkipSpaces();
+                ETI_INTERNAL_ASSERT(offset == str.size(), "unsupported enum value expression");
+                return value;
+            }
+
+        private:
+
+            constexpr void SkipSpaces()
+            {
+                while (offset < str.size() && str[offset] == ' ')
+                    ++offset;
+            }
+
+            constexpr char Peek()
+            {
+                SkipSpaces();
+                return offset < str.size() ? str[offset] : '\0';
+            }
+
+            static constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+            // binary operator at offset and its precedence (higher bind tighter), -1 if none
+            constexpr int GetPrecedence(std::string_view& op)
+            {
+                constexpr std::string_view operators[] = { "<<", ">>", "|", "^", "&", "+", "-", "*" };
+                constexpr int precedences[] = { 3, 3, 0, 1, 2, 4, 4, 5 };
+                Peek();
+                for (size_t i = 0; i < std::size(operators); ++i)
+                {
+                    if (str.substr(offset, operators[i].size()) == operators[i])
+                    {
+                        op = operators[i];
+                        return precedences[i];
+                    }
+                }
+                return -1;
+            }
+
+            constexpr std::uint64_t ParseBinary(int minPrecedence)
+            {
+                std::uint64_t lhs = ParseUnary();
+                std::string_view op;
+                for (int precedence = GetPrecedence(op); precedence >= minPrecedence; precedence = GetPrecedence(op))
+                {
+                    offset += op.size();
+                    std::uint64_t rhs = ParseBinary(precedence + 1);
+                    if (op == "<<") lhs <<= rhs;
+                    else if (op == ">>") lhs >>= rhs;
+                    else if (op == "|") lhs |= rhs;
+                    else if (op == "^") lhs ^= rhs;
+                    else if (op == "&") lhs &= rhs;
+                    else if (op == "+") lhs += rhs;
+                    else if (op == "-") lhs -= rhs;
+                    else lhs *= rhs;
+                }
+                return lhs;
+            }
+
+            constexpr std::uint64_t ParseUnary()
+            {
+                char c = Peek();
+                if (c == '-' || c == '~' || c == '+')
+                {
+                    ++offset;
+                    std::uint64_t value = ParseUnary();
+                    return c == '-' ? 0 - value : (c == '~' ? ~value : value);
+                }
+                if (c == '(')
+                {
+                    ++offset;
+                    std::uint64_t value = ParseBinary(0);
+                    ETI_INTERNAL_ASSERT(Peek() == ')', "missing ')' in enum value expression");
+                    ++offset;
+                    return value;
+                }
+                if (c == '\'')
+                {
+                    // 'a' or '\x'
+                    bool escaped = str[offset + 1] == '\\';
+                    char value = escaped ? str[offset + 2] : str[offset + 1];
+                    offset += escaped ? 4 : 3;
+                    if (escaped)
+                        value = value == 'n' ? '\n' : (value == 't' ? '\t' : (value == 'r' ? '\r' : (value == '0' ? '\0' : value)));
+                    return (std::uint64_t)value;
+                }
+                if (IsDigit(c))
+                    return ParseLiteral();
+
+                size_t first = offset;
+                while (offset < str.size() && IsIdentifierChar(str[offset]))
+                    ++offset;
+                std::string_view name = str.substr(first, offset - first);
+                for (const EnumEntry& entry : previous)
+                {
+                    if (entry.Name == name)
+                        return entry.Value;
+                }
+                ETI_INTERNAL_ASSERT(false, "unknown name in enum value expression");
+                return 0;
+            }
+
+            // decimal, hex (0x), binary (0b) or octal (0) with digit separators and u/l suffixes
+            constexpr std::uint64_t ParseLiteral()
+            {
+                std::uint64_t base = 10;
+                if (str[offset] == '0' && offset + 1 < str.size())
+                {
+                    char prefix = str[offset + 1];
+                    if (prefix == 'x' || prefix == 'X')
+                        base = 16, offset += 2;
+                    else if (prefix == 'b' || prefix == 'B')
+                        base = 2, offset += 2;
+                    else if (IsDigit(prefix) || prefix == '\'')
+                        base = 8, offset += 1;
+                }
+
+                std::uint64_t value = 0;
+                for (; offset < str.size(); ++offset)
+                {
+                    char c = str[offset];
+                    std::uint64_t digit = 0;
+                    if (c == '\'')
+                        continue;
+                    else if (IsDigit(c))
+                        digit = (std::uint64_t)(c - '0');
+                    else if (base == 16 && c >= 'a' && c <= 'f')
+                        digit = (std::uint64_t)(c - 'a' + 10);
+                    else if (base == 16 && c >= 'A' && c <= 'F')
+                        digit = (std::uint64_t)(c - 'A' + 10);
+                    else
+                        break;
+                    value = value * base + digit;
+                }
+
+                while (offset < str.size() && (str[offset] == 'u' || str[offset] == 'U' || str[offset] == 'l' || str[offset] == 'L'))
+                    ++offset;
+                return value;
+            }
+
+            std::string_view str;
+            std::span<const EnumEntry> previous;
+            size_t offset = 0;
+        };
+
+        // split stringified enum values ("A, B = 0x10, C"), value is explicit or previous value + 1
+        // converted to underlying TYPE like the enum value itself (~0u is 0xFFFFFFFF for std::uint32_t, signed values are sign extended)
+        template<typename TYPE, size_t N>
+        constexpr std::array<EnumEntry, N> MakeEnumEntries(std::string_view names)
+        {
+            std::array<EnumEntry, N> entries;
+            size_t offset = 0;
+            std::uint64_t value = 0;
+            for (size_t i = 0; i < N; ++i)
+            {
+                size_t last = FindEnumEntryEnd(names, offset);
+                std::string_view entry = names.substr(offset, last - offset);
+                offset = last + 1;
+
+                size_t assign = entry.find('=');
+                if (assign != std::string_view::npos)
+                    value = EnumValueParser(entry.substr(assign + 1), std::span<const EnumEntry>(entries.data(), i)).Parse();
+                entries[i] = { TrimSpaces(entry.substr(0, assign)), (size_t)(TYPE)value };
+                ++value;
+            }
+            return entries;
+        }
+
+        inline EnumValueLookup MakeEnumValueLookup(std::span<const EnumEntry> entries)
+        {
+            if (entries.empty())
+                return {};
+
+            // first declared entry win for aliases
+            std::vector<const EnumEntry*> uniques;
+            for (const EnumEntry& entry : entries)
+            {
+                if (std::ranges::find_if(uniques, [&entry](const EnumEntry* unique) { return unique->Value == entry.Value; }) == uniques.end())
+                    uniques.push_back(&entry);
+            }
+
+            auto [min, max] = std::ranges::minmax(uniques, {}, [](const EnumEntry* entry) { return (std::int64_t)entry->Value; });
+            std::uint64_t range = (std::uint64_t)max->Value - (std::uint64_t)min->Value;
+            if (range < std::max<std::uint64_t>(64, uniques.size() * 2))
+            {
+                std::vector<const EnumEntry*> table(range + 1);
+                for (const EnumEntry* entry : uniques)
+                    table[entry->Value - min->Value] = entry;
+                return { StoreStatic(std::move(table)), min->Value };
+            }
+
+            // multiply shift hash, search a multiplier without collision, table grow if none found
+            std::uint64_t seed = 0x9E3779B97F4A7C15ull;
+            for (std::uint32_t bits = (std::uint32_t)std::bit_width(uniques.size()) + 1;; ++bits)
+            {
+                std::vector<const EnumEntry*> table((size_t)1 << bits);
+                std::uint32_t shift = 64 - bits;
+                for (size_t attempt = 0; attempt < 1024; ++attempt)
+                {
+                    // splitmix64
+                    seed += 0x9E3779B97F4A7C15ull;
+                    std::uint64_t multiplier = seed;
+                    multiplier = (multiplier ^ (multiplier >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    multiplier = (multiplier ^ (multiplier >> 27)) * 0x94D049BB133111EBull;
+                    multiplier = (multiplier ^ (multiplier >> 31)) | 1;
+
+                    std::ranges::fill(table, nullptr);
+                    bool collision = false;
+                    for (const EnumEntry* entry : uniques)
+                    {
+                        const EnumEntry*& slot = table[(size_t)(((std::uint64_t)entry->Value * multiplier) >> shift)];
+                        if (slot != nullptr)
+                        {
+                            collision = true;
+                            break;
+                        }
+                        slot = entry;
+                    }
+                    if (!collision)
+                        return { StoreStatic(std::move(table)), 0, multiplier, shift };
+                }
+            }
+        }
+
+        // single bit entries by bit position, first declared entry win for aliases
+        inline std::span<const EnumEntry* const> MakeEnumBits(std::span<const EnumEntry> entries, size_t bitCount)
+        {
+            std::vector<const EnumEntry*> bits(bitCount);
+            for (const EnumEntry& entry : entries)
+            {
+                std::uint64_t value = GetEnumFlagsBits(entry.Value, bitCount);
+                if (std::has_single_bit(value) && bits[std::countr_zero(value)] == nullptr)
+                    bits[std::countr_zero(value)] = &entry;
+            }
+            return StoreStatic(std::move(bits));
+        }
+
+        inline const EnumEntry* FindEnumEntry(const EnumValueLookup& lookup, std::size_t value)
+        {
+            size_t index = lookup.Multiplier == 0 ? value - lookup.MinValue : (size_t)(((std::uint64_t)value * lookup.Multiplier) >> lookup.Shift);
+            if (index >= lookup.Entries.size())
+                return nullptr;
+            const EnumEntry* entry = lookup.Entries[index];
+            return entry != nullptr && entry->Value == value ? entry : nullptr;
+        }
+    }
+
+#pragma endregion
+
+#pragma region Property Implementation
+
+    template <typename T>
+    const T* Property::HaveAttribute() const
+    {
+        return GetAttribute<T>() != nullptr;
+    }
+
+    inline void* Property::UnSafeGetPtr(void* obj) const
+    {
+        return ((char*)obj + Offset);
+    }
+
+    namespace internal
+    {
+        // unrolled so loads and stores of independent elements overlap (AVX2 gather instructions are not faster)
+        template<typename T>
+        void GatherStrided(const std::byte* src, size_t stride, size_t count, std::byte* dst)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4, src += 4 * stride)
+            {
+                T a, b, c, d;
+                std::memcpy(&a, src, sizeof(T));
+                std::memcpy(&b, src + stride, sizeof(T));
+                std::memcpy(&c, src + 2 * stride, sizeof(T));
+                std::memcpy(&d, src + 3 * stride, sizeof(T));
+                std::memcpy(dst + i * sizeof(T), &a, sizeof(T));
+                std::memcpy(dst + (i + 1) * sizeof(T), &b, sizeof(T));
+                std::memcpy(dst + (i + 2) * sizeof(T), &c, sizeof(T));
+                std::memcpy(dst + (i + 3) * sizeof(T), &d, sizeof(T));
+            }
+            for (; i < count; ++i, src += stride)
+                std::memcpy(dst + i * sizeof(T), src, sizeof(T));
+        }
+
+        // no scatter instruction before AVX-512, unrolled stores
+        template<typename T>
+        void ScatterStrided(const std::byte* src, std::byte* dst, size_t stride, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4, dst += 4 * stride)
+            {
+                T a, b, c, d;
+                std::memcpy(&a, src + i * sizeof(T), sizeof(T));
+                std::memcpy(&b, src + (i + 1) * sizeof(T), sizeof(T));
+                std::memcpy(&c, src + (i + 2) * sizeof(T), sizeof(T));
+                std::memcpy(&d, src + (i + 3) * sizeof(T), sizeof(T));
+                std::memcpy(dst, &a, sizeof(T));
+                std::memcpy(dst + stride, &b, sizeof(T));
+                std::memcpy(dst + 2 * stride, &c, sizeof(T));
+                std::memcpy(dst + 3 * stride, &d, sizeof(T));
+            }
+            for (; i < count; ++i, dst += stride)
+                std::memcpy(dst, src + i * sizeof(T), sizeof(T));
+        }
+
+        inline size_t GetBatchSize(const Property& property)
+        {
+            const Declaration& declaration = property.Variable.Declaration;
+            if (!declaration.IsValue)
+                return sizeof(void*);
+            ETI_ASSERT(declaration.Type->HaveFlag(TypeFlags::TriviallyCopyable), "batched property should be trivially copyable: " << property.Variable.Name);
+            return declaration.Type->Size;
+        }
+    }
+
+    inline void Property::Gather(const void* objects, size_t stride, size_t count, void* values) const
+    {
+        if (count == 0)
+            return;
+        const std::byte* src = static_cast<const std::byte*>(objects) + Offset;
+        std::byte* dst = static_cast<std::byte*>(values);
+        switch (size_t size = internal::GetBatchSize(*this))
+        {
+            case 1: internal::GatherStrided<std::uint8_t>(src, stride, count, dst); break;
+            case 2: internal::GatherStrided<std::uint16_t>(src, stride, count, dst); break;
+            case 4: internal::GatherStrided<std::uint32_t>(src, stride, count, dst); break;
+            case 8: internal::GatherStrided<std::uint64_t>(src, stride, count, dst); break;
+            default:
+                for (size_t i = 0; i < count; ++i)
+                    std::memcpy(dst + i * size, src + i * stride, size);
+                break;
+        }
+    }
+
+    inline void Property::Scatter(void* objects, size_t stride, size_t count, const void* values) const
+    {
+        if (count == 0)
+            return;
+        std::byte* dst = static_cast<std::byte*>(objects) + Offset;
+        const std::byte* src = static_cast<const std::byte*>(values);
+        switch (size_t size = internal::GetBatchSize(*this))
+        {
+            case 1: internal::ScatterStrided<std::uint8_t>(src, dst, stride, count); break;
+            case 2: internal::ScatterStrided<std::uint16_t>(src, dst, stride, count); break;
+            case 4: internal::ScatterStrided<std::uint32_t>(src, dst, stride, count); break;
+            case 8: internal::ScatterStrided<std::uint64_t>(src, dst, stride, count); break;
+            default:
+                for (size_t i = 0; i < count; ++i)
+                    std::memcpy(dst + i * stride, src + i * size, size);
+                break;
+        }
+    }
+
+    template <typename OBJECT, typename T>
+    void Property::Set(OBJECT& obj, const T& value) const
+    {
+        ETI_ASSERT(IsA(TypeOf<OBJECT>(), Parent), "Invalid object type" << TypeOf<OBJECT>().Name << ", should be: " << Parent.Name);
+
+        if (Variable.Declaration.IsPtr)
+        {
+            ETI_ASSERT(Variable.Declaration.IsPtr && std::is_pointer_v<T>, "try to set a pointer property providing not pointer value");
+            ETI_ASSERT(IsA( TypeOf<T>(), *Variable.Declaration.Type ), "bad pointer type: " << TypeOf<T>().Name << "trying to set ptr of type: " << Variable.Declaration.Type->Name);
+            T* ptr = (T*)UnSafeGetPtr(&obj);
+            *ptr = value;
+        }
+        else
+        {
+            ETI_ASSERT(!Variable.Declaration.IsPtr && !std::is_pointer_v<T>, "try to set a value property providing a pointer value");
+            ETI_ASSERT( TypeOf<T>() == *Variable.Declaration.Type, "bad value type: " << TypeOf<T>().Name << "trying to set value of type: " << Variable.Declaration.Type->Name);
+            T* ptr = (T*)UnSafeGetPtr(&obj);
+            *ptr = value;
+        }
+    }
+
+    template <typename OBJECT, typename T>
+    void Property::Get(OBJECT& obj, T& value) const
+    {
+        ETI_ASSERT(IsA(TypeOf<OBJECT>(), Parent), "Invalid object type" << TypeOf<OBJECT>().Name << ", should be: " << Parent.Name);
+
+        if (Variable.Declaration.IsPtr)
+        {
+            ETI_ASSERT(Variable.Declaration.IsPtr && std::is_pointer_v<T>, "try to set a pointer property providing not pointer value");
+            ETI_ASSERT( IsA( TypeOf<T>(), *Variable.Declaration.Type ), "bad pointer type: " << TypeOf<T>().Name << "trying to set ptr of type: " << Variable.Declaration.Type->Name);
+            T* ptr = (T*)UnSafeGetPtr(&obj);
+            value = *ptr;
+        }
+        else
+        {
+            ETI_ASSERT(!Variable.Declaration.IsPtr && !std::is_pointer_v<T>, "try to set a value property providing a pointer value");
+            ETI_ASSERT( TypeOf<T>() == *Variable.Declaration.Type, "bad value type: " << TypeOf<T>().Name << "trying to set value of type: " << Variable.Declaration.Type->Name);
+            T* ptr = (T*)UnSafeGetPtr(&obj);
+            value = *ptr;
+        }
+    }
+
+#pragma endregion
+
+#pragma region Method Implementation
+
+    template <typename T>
+    const T* Method::GetAttribute() const
+    {
+        for (const std::shared_ptr<Attribute>& a : Attributes)
+        {
+            if (IsA<T>(*a))
+                return Cast<T>(a.get());
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    const T* Method::HaveAttribute() const
+    {
+        return GetAttribute<T>() != nullptr;
+    }
+
+
+    // Arguments validation
+    template<typename T>
+    void ValidateArgument(const Variable& argument, int index)
+    {
+        if (argument.Declaration.IsPtr)
+        {
+            ETI_ASSERT(std::is_pointer_v<T>, "expected pointer argument");
+            ETI_ASSERT(IsA(TypeOf<T>(), *argument.Declaration.Type), "argument " << index << " must be of type: " << argument.Declaration.Type->Name << ", not " << TypeOf<T>().Name);
+        }
+        else if ( argument.Declaration.IsRef)
+        {
+            ETI_ASSERT(std::is_pointer_v<T>, "expected pointer as arguments (for ref use pointer)");
+            ETI_ASSERT(IsA(TypeOf<T>(), *argument.Declaration.Type), "argument " << index << " must be of type: " << argument.Declaration.Type->Name << ", not " << TypeOf<T>().Name);
+        }
+        else
+        {
+            ETI_ASSERT(TypeOf<T>() == *argument.Declaration.Type, "argument " << index << " must be of type: " << argument.Declaration.Type->Name << ", not " << TypeOf<T>().Name);
+        }
+    }
+
+    template<typename... Ts, std::size_t... Is>
+    void ValidateArgumentsForEach(std::span<const Variable> arguments, std::index_sequence<Is...>)
+    {
+        (ValidateArgument<Ts>(arguments[Is], Is), ...);
+    }
+
+    template<typename... Args>
+    void ValidateArguments(std::span<const Variable> arguments)
+    {
+        ETI_ASSERT(arguments.size() == sizeof...(Args), "argument count missmatch, method need " << arguments.size() << ", " << sizeof...(Args) << " provided");
+        ValidateArgumentsForEach<Args...>(arguments, std::index_sequence_for<Args...>{});
+    }
+
+    template <typename PARENT, typename RETURN, typename... ARGS>
+    void Method::CallMethod(PARENT& owner, RETURN* ret, ARGS... args) const
+    {
+        if (ret == nullptr)
+            ETI_ASSERT(Return->Declaration.Type->Kind == Kind::Void, "cannot provide return value on method returning void: " << Parent->Name << "::" << Name <<"()");
+        else
+            ETI_ASSERT(Return->Declaration.Type->Kind != Kind::Void, "missing return value on method with return: " << Parent->Name << "::" << Name <<"()");
+
+        if (!IsLambda)
+            ValidateArguments<ARGS...>(Arguments);
+        else
+            ValidateArguments<PARENT*, ARGS...>(Arguments);
+
+        std::array<void*, sizeof...(ARGS)> voidArgs = internal::GetVoidPtrFromArgs(args...);
+
+        UnSafeCall(&owner, ret, voidArgs);
+    }
+     
+    template <typename RETURN, typename... ARGS>
+    void Method::CallStaticMethod(RETURN* ret, ARGS... args) const
+    {
+        if (ret == nullptr)
+            ETI_ASSERT(Return->Declaration.Type->Kind == Kind::Void, "cannot provide return value on method returning void: " << Parent->Name << "::" << Name <<"()");
+        else
+            ETI_ASSERT(Return->Declaration.Type->Kind != Kind::Void, "missing return value on method with return: %s::%s()" << Parent->Name << "::" << Name <<"()");
+
+        ValidateArguments<ARGS...>(Arguments);
+
+        std::array<void*, sizeof...(ARGS)> voidArgs = internal::GetVoidPtrFromArgs(args...);
+
+        UnSafeCall(nullptr, ret, voidArgs);
+    }
+
+    inline void Method::UnSafeCall(void* obj, void* ret, std::span<void*> args) const
+    {
+        if (IsStatic)
+            ETI_ASSERT(obj == nullptr, "try to call static method on object instance");
+        else
+            ETI_ASSERT(obj != nullptr, "call member method without object instance");
+
+        if (Return->Declaration.Type->Kind == Kind::Void)
+            ETI_ASSERT(ret == nullptr, "try to call method with no return value, but provided return argument is not nullptr");
+        else
+            ETI_ASSERT(ret != nullptr, "try to call method with return value, but provided return argument is nullptr");
+
+        if (IsLambda)
+        {
+            // lambda take owner as first argument, prepend it on the stack
+            // checked even when assert is compiled out, method is not called rather than overflow objArgs
+            ETI_ASSERT(args.size() <= ETI_METHOD_ARGUMENTS_MAX, "too many arguments, see ETI_METHOD_ARGUMENTS_MAX");
+            if (args.size() > ETI_METHOD_ARGUMENTS_MAX)
+                return;
+            std::array<void*, ETI_METHOD_ARGUMENTS_MAX + 1> objArgs;
+            objArgs[0] = &obj;
+            std::copy(args.begin(), args.end(), objArgs.begin() + 1);
+            this->Function(nullptr, ret, std::span<void*>(objArgs.data(), args.size() + 1));
+        }
+        else
+        {
+            this->Function(obj, ret, args);
+        }
+    }
+
+#pragma endregion
+
+#pragma region Type Implementation
+
+    inline const Property* Type::GetProperty(std::string_view name) const
+    {
+        return internal::FindMember(PropertyTable, name);
+    }
+
+    inline const Property* Type::GetProperty(TypeId propertyId) const
+    {
+        return internal::FindMember(PropertyTable, propertyId);
+    }
+
+    inline const Method* Type::GetMethod(std::string_view name) const
+    {
+        return internal::FindMember(MethodTable, name);
+    }
+
+    inline const Method* Type::GetMethod(TypeId methodId) const
+    {
+        return internal::FindMember(MethodTable, methodId);
+    }
+
+    template <typename T>
+    const T* Type::GetAttribute() const
+    {
+        for (const std::shared_ptr<Attribute>& a : Attributes)
+        {
+            if (IsA<T>(*a))
+                return Cast<T>(a.get());
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    const T* Type::HaveAttribute() const
+    {
+        return GetAttribute<T>() != nullptr;
+    }
+
+    inline std::size_t Type::GetEnumValue(std::string_view enumName) const
+    {
+        ETI_ASSERT(Kind == Kind::Enum, "GetEnumValue should be only called with enum");
+        if (const EnumEntry* entry = internal::FindMember(EnumNameTable, enumName))
+            return entry->Value;
+        return InvalidIndex;
+    }
+
+    inline std::string_view Type::GetEnumValueName(size_t enumValue) const
+    {
+        ETI_ASSERT(Kind == Kind::Enum, "GetEnumValueName should be only called with enum");
+        if (const EnumEntry* entry = internal::FindEnumEntry(EnumValueTable, enumValue))
+            return entry->Name;
+        return {};
+    }
+
+    inline TypeId Type::GetEnumValueHash(std::size_t enumValue) const
+    {
+        ETI_ASSERT(Kind == Kind::Enum, "GetEnumValueHash should be only called with enum");
+        return utils::GetStringHash(GetEnumValueName(enumValue));
+    }
+
+    inline std::size_t Type::FormatEnumFlags(std::size_t enumValue, std::span<char> buffer) const
+    {
+        ETI_ASSERT(Kind == Kind::Enum && EnumFlags, "FormatEnumFlags should be only called with flags enum");
+
+        size_t size = 0;
+        auto append = [&size, buffer](std::string_view str)
+        {
+            if (size + str.size() > buffer.size())
+                return false;
+            std::ranges::copy(str, buffer.begin() + size);
+            size += str.size();
+            return true;
+        };
+
+        if (const EnumEntry* entry = internal::FindEnumEntry(EnumValueTable, enumValue))
+            return append(entry->Name) ? size : InvalidIndex;
+
+        // one name by set bit, lowest bit first
+        for (std::uint64_t bits = internal::GetEnumFlagsBits(enumValue, EnumBits.size()); bits != 0; bits &= bits - 1)
+        {
+            const EnumEntry* entry = EnumBits[std::countr_zero(bits)];
+            if (entry == nullptr || (size != 0 && !append("|")) || !append(entry->Name))
+                return InvalidIndex;
+        }
+        return size;
+    }
+
+    inline bool Type::ParseEnumFlags(std::string_view str, std::size_t& enumValue) const
+    {
+        ETI_ASSERT(Kind == Kind::Enum && EnumFlags, "ParseEnumFlags should be only called with flags enum");
+
+        std::size_t value = 0;
+        for (size_t offset = 0; offset <= str.size();)
+        {
+            size_t last = str.find('|', offset);
+            if (last == std::string_view::npos)
+                last = str.size();
+            std::string_view name = internal::TrimSpaces(str.substr(offset, last - offset));
+            offset = last + 1;
+
+            // empty string is no flags
+            if (name.empty() && str.find_first_not_of(' ') == std::string_view::npos)
+                break;
+
+            const EnumEntry* entry = internal::FindMember(EnumNameTable, name);
+            if (entry == nullptr)
+                return false;
+            value |= entry->Value;
+        }
+        enumValue = value;
+        return true;
+    }
+
+    namespace internal
+    {
+        struct PoolBlock
+        {
+            PoolBlock* Next;
+        };
+
+        // blocks move by batch between thread free lists and the shared free list
+        constexpr size_t PoolBatchSize = 64;
+        constexpr size_t PoolMinSlabSize = 64 * 1024;
+
+        struct TypePool
+        {
+            std::mutex Mutex;
+            PoolBlock* Free = nullptr;
+            std::vector<void*> Slabs;
+            std::atomic<size_t> SlabCount = 0;
+            size_t BlockSize = 0;
+            size_t BlockAlign = 0;
+            size_t SlabSize = 0;
+        };
+
+        inline TypePool& GetTypePool(const Type& type)
+        {
+            ETI_ASSERT(type.Index != InvalidIndex, "pooled type should be registered (no Kind::Forward)");
+
+            // never destroyed, thread free lists are given back at thread exit, maybe after static destruction
+            static std::mutex& mutex = *new std::mutex;
+            static std::vector<TypePool*>& pools = *new std::vector<TypePool*>;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (type.Index >= pools.size())
+                pools.resize(type.Index + 1, nullptr);
+            TypePool*& pool = pools[type.Index];
+            if (pool == nullptr)
+            {
+                pool = new TypePool;
+                pool->BlockAlign = std::max(type.Align, alignof(PoolBlock));
+                pool->BlockSize = (std::max(type.Size, sizeof(PoolBlock)) + pool->BlockAlign - 1) & ~(pool->BlockAlign - 1);
+                size_t slabSize = std::max(PoolMinSlabSize, PoolBatchSize * pool->BlockSize);
+                pool->SlabSize = slabSize - slabSize % pool->BlockSize;
+            }
+            return *pool;
+        }
+
+        struct PoolFreeList
+        {
+            TypePool* Pool = nullptr;
+            PoolBlock* Free = nullptr;
+            size_t Count = 0;
+        };
+
+        // give back blocks over keep count to shared free list
+        inline void ReleasePoolBlocks(PoolFreeList& freeList, size_t keep)
+        {
+            if (freeList.Count <= keep)
+                return;
+
+            PoolBlock* first = freeList.Free;
+            PoolBlock* last = first;
+            for (size_t i = keep + 1; i < freeList.Count; ++i)
+                last = last->Next;
+            freeList.Free = last->Next;
+            freeList.Count = keep;
+
+            std::lock_guard<std::mutex> lock(freeList.Pool->Mutex);
+            last->Next = freeList.Pool->Free;
+            freeList.Pool->Free = first;
+        }
+
+        // take a batch from shared free list, new slab if empty
+        inline void AcquirePoolBlocks(PoolFreeList& freeList)
+        {
+            TypePool& pool = *freeList.Pool;
+            std::lock_guard<std::mutex> lock(pool.Mutex);
+            if (pool.Free == nullptr)
+            {
+                std::byte* slab = static_cast<std::byte*>(::operator new(pool.SlabSize, std::align_val_t(pool.BlockAlign)));
+                pool.Slabs.push_back(slab);
+                pool.SlabCount.fetch_add(1, std::memory_order_relaxed);
+                for (size_t offset = pool.SlabSize; offset != 0;)
+                {
+                    offset -= pool.BlockSize;
+                    PoolBlock* block = reinterpret_cast<PoolBlock*>(slab + offset);
+                    block->Next = pool.Free;
+                    pool.Free = block;
+                }
+            }
+            for (size_t i = 0; i < PoolBatchSize && pool.Free != nullptr; ++i)
+            {
+                PoolBlock* block = pool.Free;
+                pool.Free = block->Next;
+                block->Next = freeList.Free;
+                freeList.Free = block;
+                ++freeList.Count;
+            }
+        }
+
+        struct PoolFreeLists
+        {
+            std::vector<PoolFreeList> Lists;
+
+            ~PoolFreeLists()
+            {
+                for (PoolFreeList& freeList : Lists)
+                {
+                    if (freeList.Pool != nullptr)
+                        ReleasePoolBlocks(freeList, 0);
+                }
+            }
+        };
+
+        // this thread free list of type, by Type::Index
+        inline PoolFreeList& GetPoolFreeList(const Type& type)
+        {
+            thread_local PoolFreeLists freeLists;
+            if (type.Index >= freeLists.Lists.size())
+                freeLists.Lists.resize(std::max(type.Index + 1, GetTypeIndexCount()));
+            PoolFreeList& freeList = freeLists.Lists[type.Index];
+            if (freeList.Pool == nullptr)
+                freeList.Pool = &GetTypePool(type);
+            return freeList;
+        }
+    }
+
+    inline void* Type::NewPooled() const
+    {
+        ETI_ASSERT(HaveConstruct() && HaveDestroy(), "NewPooled need default constructible and destructible type");
+
+        internal::PoolFreeList& freeList = internal::GetPoolFreeList(*this);
+        if (freeList.Free == nullptr)
+            internal::AcquirePoolBlocks(freeList);
+        internal::PoolBlock* block = freeList.Free;
+        freeList.Free = block->Next;
+        --freeList.Count;
+
+        void* obj = block;
+        try
+        {
+            Construct(obj);
+        }
+        catch (...)
+        {
+            // give block back, constructor failure should not shrink the pool
+            block->Next = freeList.Free;
+            freeList.Free = block;
+            ++freeList.Count;
+            throw;
+        }
+        return obj;
+    }
+
+    inline void Type::DeletePooled(void* obj) const
+    {
+        if (obj == nullptr)
+            return;
+
+        Destruct(obj);
+
+        internal::PoolFreeList& freeList = internal::GetPoolFreeList(*this);
+        internal::PoolBlock* block = static_cast<internal::PoolBlock*>(obj);
+        block->Next = freeList.Free;
+        freeList.Free = block;
+        if (++freeList.Count > 2 * internal::PoolBatchSize)
+            internal::ReleasePoolBlocks(freeList, internal::PoolBatchSize);
+    }
+
+    inline PoolStats Type::GetPoolStats() const
+    {
+        internal::TypePool& pool = internal::GetTypePool(*this);
+        return { pool.BlockSize, pool.SlabSize, pool.SlabCount.load(std::memory_order_relaxed) };
+    }
+
+#pragma endregion
+
+#pragma region DynamicArray Implementation
+
+    inline DynamicArray::DynamicArray(const Type& type) : type(&type)
+    {
+        ETI_ASSERT(type.HaveRelocate() && type.HaveDestroyN(), "DynamicArray type should be move constructible and destructible");
+    }
+
+    inline DynamicArray::DynamicArray(const DynamicArray& other) : type(other.type)
+    {
+        *this = other;
+    }
+
+    inline DynamicArray::DynamicArray(DynamicArray&& other) noexcept : type(other.type), data(other.data), size(other.size), capacity(other.capacity)
+    {
+        other.data = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+    }
+
+    inline DynamicArray& DynamicArray::operator=(const DynamicArray& other)
+    {
+        if (this == &other)
+            return *this;
+        ETI_ASSERT(other.type->HaveCopyConstructN(), "DynamicArray type should be copy constructible");
+        Release();
+        type = other.type;
+        Reserve(other.size);
+        type->CopyConstructN(other.data, data, other.size);
+        size = other.size;
+        return *this;
+    }
+
+    inline DynamicArray& DynamicArray::operator=(DynamicArray&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        Release();
+        type = other.type;
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+        return *this;
+    }
+
+    inline DynamicArray::~DynamicArray()
+    {
+        Release();
+    }
+
+    inline void* DynamicArray::Get(size_t index)
+    {
+        ETI_ASSERT(index < size, "index out of range");
+        return data + index * type->Size;
+    }
+
+    inline const void* DynamicArray::Get(size_t index) const
+    {
+        ETI_ASSERT(index < size, "index out of range");
+        return data + index * type->Size;
+    }
+
+    inline void DynamicArray::Reserve(size_t newCapacity)
+    {
+        if (newCapacity > capacity)
+            Reallocate(newCapacity);
+    }
+
+    inline void DynamicArray::Resize(size_t newSize)
+    {
+        if (newSize > size)
+            Insert(size, newSize - size);
+        else if (newSize < size)
+            Erase(newSize, size - newSize);
+    }
+
+    inline void DynamicArray::Clear()
+    {
+        type->DestructN(data, size);
+        size = 0;
+    }
+
+    inline void* DynamicArray::PushBack()
+    {
+        return Insert(size, 1);
+    }
+
+    inline void* DynamicArray::PushBack(const void* value)
+    {
+        return Insert(size, value, 1);
+    }
+
+    inline void DynamicArray::PopBack()
+    {
+        ETI_ASSERT(size != 0, "PopBack on empty array");
+        Erase(size - 1, 1);
+    }
+
+    inline void* DynamicArray::Insert(size_t index, size_t count)
+    {
+        ETI_ASSERT(type->HaveConstructN(), "DynamicArray type should be default constructible");
+        return InsertConstructed(index, count, [this, count](std::byte* first) { type->ConstructN(first, count); });
+    }
+
+    inline void* DynamicArray::Insert(size_t index, const void* values, size_t count)
+    {
+        ETI_ASSERT(type->HaveCopyConstructN(), "DynamicArray type should be copy constructible");
+        ETI_ASSERT(values < data || values >= data + capacity * type->Size, "values should not be in array");
+        return InsertConstructed(index, count, [this, values, count](std::byte* first) { type->CopyConstructN(values, first, count); });
+    }
+
+    inline void DynamicArray::Erase(size_t index, size_t count)
+    {
+        ETI_ASSERT(index + count <= size, "erase out of range");
+        std::byte* first = data + index * type->Size;
+        type->DestructN(first, count);
+        type->Relocate(first + count * type->Size, first, size - index - count);
+        size -= count;
+    }
+
+    template<typename T>
+    std::span<T> DynamicArray::AsSpan()
+    {
+        ETI_ASSERT(*type == TypeOf<T>(), "T should be array type");
+        return { reinterpret_cast<T*>(data), size };
+    }
+
+    template<typename T>
+    std::span<const T> DynamicArray::AsSpan() const
+    {
+        ETI_ASSERT(*type == TypeOf<T>(), "T should be array type");
+        return { reinterpret_cast<const T*>(data), size };
+    }
+
+    inline void* DynamicArray::GetMember(size_t index, const Property& property)
+    {
+        ETI_ASSERT(IsA(*type, property.Parent), "property should be a member of array type");
+        return static_cast<std::byte*>(Get(index)) + property.Offset;
+    }
+
+    template<typename T>
+    MemberView<T> DynamicArray::GetMembers(const Property& property)
+    {
+        ETI_ASSERT(IsA(*type, property.Parent), "property should be a member of array type");
+        ETI_ASSERT(property.Variable.Declaration.IsValue && *property.Variable.Declaration.Type == TypeOf<T>(), "T should be property type");
+        return { data != nullptr ? data + property.Offset : nullptr, type->Size, size };
+    }
+
+    // relocation is expected not to throw (move constructor)
+    template<typename CONSTRUCT>
+    std::byte* DynamicArray::InsertConstructed(size_t index, size_t count, CONSTRUCT&& construct)
+    {
+        ETI_ASSERT(index <= size, "index out of range");
+        size_t stride = type->Size;
+        size_t tail = size - index;
+        if (size + count <= capacity)
+        {
+            // tail moved up then back if construction throw
+            std::byte* first = data + index * stride;
+            if (tail != 0)
+                type->Relocate(first, first + count * stride, tail);
+            try
+            {
+                construct(first);
+            }
+            catch (...)
+            {
+                if (tail != 0)
+                    type->Relocate(first + count * stride, first, tail);
+                throw;
+            }
+            size += count;
+            return first;
+        }
+
+        // amortized growth, new elements are built in new storage first (like std::vector), then others are relocated around them
+        size_t newCapacity = std::max(size + count, capacity * 2);
+        std::byte* newData = static_cast<std::byte*>(::operator new(newCapacity * stride, std::align_val_t(type->Align)));
+        try
+        {
+            construct(newData + index * stride);
+        }
+        catch (...)
+        {
+            ::operator delete(newData, std::align_val_t(type->Align));
+            throw;
+        }
+        type->Relocate(data, newData, index);
+        type->Relocate(data + index * stride, newData + (index + count) * stride, tail);
+        if (data != nullptr)
+            ::operator delete(data, std::align_val_t(type->Align));
+        data = newData;
+        capacity = newCapacity;
+        size += count;
+        return data + index * stride;
+    }
+
+    inline void DynamicArray::Reallocate(size_t newCapacity)
+    {
+        std::byte* newData = static_cast<std::byte*>(::operator new(newCapacity * type->Size, std::align_val_t(type->Align)));
+        type->Relocate(data, newData, size);
+        if (data != nullptr)
+            ::operator delete(data, std::align_val_t(type->Align));
+        data = newData;
+        capacity = newCapacity;
+    }
+
+    inline void DynamicArray::Release()
+    {
+        if (data == nullptr)
+            return;
+        type->DestructN(data, size);
+        ::operator delete(data, std::align_val_t(type->Align));
+        data = nullptr;
+        size = 0;
+        capacity = 0;
+    }
+
+#pragma endregion
+
+#pragma region SoAVector Implementation
+
+    template<typename T>
+    SoAVector<T>::SoAVector()
+    {
+    }
+
+    // delegating constructor: on throw destructor release storage, constructed elements are destructed here
+    template<typename T>
+    SoAVector<T>::SoAVector(const std::vector<T>& values) : SoAVector()
+    {
+        Reserve(values.size());
+        const std::byte* bytes = reinterpret_cast<const std::byte*>(values.data());
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            Column& column = columns[c];
+            if (column.Trivial)
+            {
+                column.Property->Gather(bytes, sizeof(T), values.size(), column.Data);
+                continue;
+            }
+
+            size_t i = 0;
+            try
+            {
+                for (; i < values.size(); ++i)
+                    column.Type->CopyConstruct(const_cast<std::byte*>(bytes + i * sizeof(T) + column.Property->Offset), column.Data + i * column.Size);
+            }
+            catch (...)
+            {
+                column.Type->DestructN(column.Data, i);
+                DestructColumns(c, 0, values.size());
+                throw;
+            }
+        }
+        size = values.size();
+    }
+
+    template<typename T>
+    SoAVector<T>::SoAVector(const SoAVector& other) : SoAVector()
+    {
+        *this = other;
+    }
+
+    template<typename T>
+    SoAVector<T>::SoAVector(SoAVector&& other) noexcept : columns(std::move(other.columns)), size(other.size), capacity(other.capacity)
+    {
+        // moved from vector is left without columns, like a default constructed one
+        other.columns.clear();
+        other.size = 0;
+        other.capacity = 0;
+    }
+
+    template<typename T>
+    SoAVector<T>& SoAVector<T>::operator=(const SoAVector& other)
+    {
+        if (this == &other)
+            return *this;
+        Clear();
+        if (other.size == 0)
+            return *this;
+        Reserve(other.size);
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            Column& column = columns[c];
+            if (column.Trivial)
+            {
+                std::memcpy(column.Data, other.columns[c].Data, other.size * column.Size);
+                continue;
+            }
+
+            // CopyConstructN leave nothing constructed on throw
+            try
+            {
+                column.Type->CopyConstructN(other.columns[c].Data, column.Data, other.size);
+            }
+            catch (...)
+            {
+                DestructColumns(c, 0, other.size);
+                throw;
+            }
+        }
+        size = other.size;
+        return *this;
+    }
+
+    template<typename T>
+    SoAVector<T>& SoAVector<T>::operator=(SoAVector&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        std::swap(columns, other.columns);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+        other.Release();
+        return *this;
+    }
+
+    template<typename T>
+    SoAVector<T>::~SoAVector()
+    {
+        Release();
+    }
+
+    template<typename T>
+    void SoAVector<T>::Reserve(size_t newCapacity)
+    {
+        if (newCapacity > capacity)
+            Reallocate(newCapacity);
+    }
+
+    template<typename T>
+    void SoAVector<T>::Clear()
+    {
+        for (Column& column : columns)
+        {
+            if (!column.Trivial)
+                column.Type->DestructN(column.Data, size);
+        }
+        size = 0;
+    }
+
+    template<typename T>
+    void SoAVector<T>::PushBack(const T& value)
+    {
+        if (size == capacity)
+            Reallocate(std::max<size_t>(capacity * 2, ColumnAlign));
+
+        const std::byte* bytes = reinterpret_cast<const std::byte*>(&value);
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            Column& column = columns[c];
+            const std::byte* member = bytes + column.Property->Offset;
+            std::byte* dst = column.Data + size * column.Size;
+            if (column.Trivial)
+            {
+                std::memcpy(dst, member, column.Size);
+                continue;
+            }
+
+            try
+            {
+                column.Type->CopyConstruct(const_cast<std::byte*>(member), dst);
+            }
+            catch (...)
+            {
+                DestructColumns(c, size, 1);
+                throw;
+            }
+        }
+        ++size;
+    }
+
+    template<typename T>
+    void SoAVector<T>::PopBack()
+    {
+        ETI_ASSERT(size != 0, "PopBack on empty SoAVector");
+        Erase(size - 1, 1);
+    }
+
+    template<typename T>
+    void SoAVector<T>::Erase(size_t index, size_t count)
+    {
+        ETI_ASSERT(index + count <= size, "erase out of range");
+        for (Column& column : columns)
+        {
+            std::byte* first = column.Data + index * column.Size;
+            std::byte* last = first + count * column.Size;
+            size_t tail = size - index - count;
+            if (column.Trivial)
+            {
+                if (tail != 0)
+                    std::memmove(first, last, tail * column.Size);
+            }
+            else
+            {
+                column.Type->DestructN(first, count);
+                column.Type->Relocate(last, first, tail);
+            }
+        }
+        size -= count;
+    }
+
+    template<typename T>
+    T SoAVector<T>::Get(size_t index) const
+    {
+        ETI_ASSERT(index < size, "index out of range");
+        T value{};
+        std::byte* bytes = reinterpret_cast<std::byte*>(&value);
+        for (const Column& column : columns)
+        {
+            std::byte* member = bytes + column.Property->Offset;
+            std::byte* src = column.Data + index * column.Size;
+            if (column.Trivial)
+            {
+                std::memcpy(member, src, column.Size);
+            }
+            else
+            {
+                CopyReplace(*column.Type, src, member);
+            }
+        }
+        return value;
+    }
+
+    template<typename T>
+    void SoAVector<T>::Set(size_t index, const T& value)
+    {
+        ETI_ASSERT(index < size, "index out of range");
+        const std::byte* bytes = reinterpret_cast<const std::byte*>(&value);
+        for (Column& column : columns)
+        {
+            const std::byte* member = bytes + column.Property->Offset;
+            std::byte* dst = column.Data + index * column.Size;
+            if (column.Trivial)
             {
-                if (str[i] == c)
-                    count++;
+                std::memcpy(dst, member, column.Size);
+            }
+            else
+            {
+                CopyReplace(*column.Type, member, dst);
             }
-            return count;    
         }
+    }
 
-        constexpr std::string_view GetEnumNameWithOffset(std::string_view names, size_t index, size_t offset/* = 0*/)
+    template<typename T>
+    std::vector<T> SoAVector<T>::ToVector() const
+    {
+        std::vector<T> values(size);
+        std::byte* bytes = reinterpret_cast<std::byte*>(values.data());
+        for (const Column& column : columns)
         {
-            if (index == 0)
+            if (column.Trivial)
             {
-                auto first = names.find_first_not_of(' ', offset);
-                auto last = names.find_first_of(',', first + 1);
-                if (last == std::string_view::npos)
-                    last = names.size();
-                std::string_view name = names.substr(first, last - first);
-                return name;
+                column.Property->Scatter(bytes, sizeof(T), size, column.Data);
             }
             else
             {
-                auto nextOffset = names.find_first_of(',', offset) + 1;
-                return GetEnumNameWithOffset(names, index - 1, nextOffset);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    std::byte* member = bytes + i * sizeof(T) + column.Property->Offset;
+                    CopyReplace(*column.Type, column.Data + i * column.Size, member);
+                }
             }
         }
+        return values;
     }
 
-#pragma endregion
-
-#pragma region Property Implementation
+    template<typename T>
+    const typename SoAVector<T>::Column* SoAVector<T>::FindColumn(TypeId propertyId) const
+    {
+        for (const Column& column : GetColumns())
+        {
+            if (column.Property->PropertyId == propertyId)
+                return &column;
+        }
+        return nullptr;
+    }
 
-    template <typename T>
-    const T* Property::HaveAttribute() const
+    template<typename T>
+    template<typename U>
+    std::span<U> SoAVector<T>::GetColumn(TypeId propertyId)
     {
-        return GetAttribute<T>() != nullptr;
+        const Column* column = FindColumn(propertyId);
+        ETI_ASSERT(column != nullptr && column->Size == sizeof(U) && (column->Type == nullptr || *column->Type == TypeOf<U>()), "U should be property type");
+        return { reinterpret_cast<U*>(column->Data), size };
     }
 
-    inline void* Property::UnSafeGetPtr(void* obj) const
+    template<typename T>
+    template<typename U>
+    std::span<const U> SoAVector<T>::GetColumn(TypeId propertyId) const
     {
-        return ((char*)obj + Offset);
+        const Column* column = FindColumn(propertyId);
+        ETI_ASSERT(column != nullptr && column->Size == sizeof(U) && (column->Type == nullptr || *column->Type == TypeOf<U>()), "U should be property type");
+        return { reinterpret_cast<const U*>(column->Data), size };
     }
 
-    template <typename OBJECT, typename T>
-    void Property::Set(OBJECT& obj, const T& value) const
+    template<typename T>
+    const std::vector<typename SoAVector<T>::Column>& SoAVector<T>::GetLayout()
     {
-        ETI_ASSERT(IsA(TypeOf<OBJECT>(), Parent), "Invalid object type" << TypeOf<OBJECT>().Name << ", should be: " << Parent.Name);
+        static const std::vector<Column> layout = []()
+        {
+            std::vector<Column> columns;
+            AppendColumns(columns, TypeOf<T>());
+            return columns;
+        }();
+        return layout;
+    }
 
-        if (Variable.Declaration.IsPtr)
+    // single inheritance, parent properties are at same offset in T
+    template<typename T>
+    void SoAVector<T>::AppendColumns(std::vector<Column>& columns, const Type& type)
+    {
+        if (type.Parent != nullptr)
+            AppendColumns(columns, *type.Parent);
+        for (const Property& property : type.Properties)
         {
-            ETI_ASSERT(Variable.Declaration.IsPtr && std::is_pointer_v<T>, "try to set a pointer property providing not pointer value");
-            ETI_ASSERT(IsA( TypeOf<T>(), *Variable.Declaration.Type ), "bad pointer type: " << TypeOf<T>().Name << "trying to set ptr of type: " << Variable.Declaration.Type->Name);
-            T* ptr = (T*)UnSafeGetPtr(&obj);
-            *ptr = value;
+            const Declaration& declaration = property.Variable.Declaration;
+            Column column;
+            column.Property = &property;
+            if (declaration.IsValue)
+            {
+                ETI_ASSERT(declaration.Type->HaveCopyConstruct() && declaration.Type->HaveRelocate(), "SoAVector properties should be copy and move constructible");
+                column.Type = declaration.Type;
+                column.Size = declaration.Type->Size;
+                column.Trivial = declaration.Type->HaveFlag(TypeFlags::TriviallyCopyable);
+            }
+            else
+            {
+                column.Size = sizeof(void*);
+                column.Trivial = true;
+            }
+            columns.push_back(column);
         }
-        else
+    }
+
+    template<typename T>
+    void SoAVector<T>::DestructColumns(size_t columnCount, size_t first, size_t count)
+    {
+        for (size_t c = 0; c < columnCount; ++c)
         {
-            ETI_ASSERT(!Variable.Declaration.IsPtr && !std::is_pointer_v<T>, "try to set a value property providing a pointer value");
-            ETI_ASSERT( TypeOf<T>() == *Variable.Declaration.Type, "bad value type: " << TypeOf<T>().Name << "trying to set value of type: " << Variable.Declaration.Type->Name);
-            T* ptr = (T*)UnSafeGetPtr(&obj);
-            *ptr = value;
+            const Column& column = columns[c];
+            if (!column.Trivial)
+                column.Type->DestructN(column.Data + first * column.Size, count);
         }
     }
 
-    template <typename OBJECT, typename T>
-    void Property::Get(OBJECT& obj, T& value) const
+    template<typename T>
+    void SoAVector<T>::CopyReplace(const Type& type, const std::byte* src, std::byte* dst)
     {
-        ETI_ASSERT(IsA(TypeOf<OBJECT>(), Parent), "Invalid object type" << TypeOf<OBJECT>().Name << ", should be: " << Parent.Name);
-
-        if (Variable.Declaration.IsPtr)
+        std::byte* copy = static_cast<std::byte*>(::operator new(type.Size, std::align_val_t(type.Align)));
+        try
         {
-            ETI_ASSERT(Variable.Declaration.IsPtr && std::is_pointer_v<T>, "try to set a pointer property providing not pointer value");
-            ETI_ASSERT( IsA( TypeOf<T>(), *Variable.Declaration.Type ), "bad pointer type: " << TypeOf<T>().Name << "trying to set ptr of type: " << Variable.Declaration.Type->Name);
-            T* ptr = (T*)UnSafeGetPtr(&obj);
-            value = *ptr;
+            type.CopyConstruct(const_cast<std::byte*>(src), copy);
         }
-        else
+        catch (...)
         {
-            ETI_ASSERT(!Variable.Declaration.IsPtr && !std::is_pointer_v<T>, "try to set a value property providing a pointer value");
-            ETI_ASSERT( TypeOf<T>() == *Variable.Declaration.Type, "bad value type: " << TypeOf<T>().Name << "trying to set value of type: " << Variable.Declaration.Type->Name);
-            T* ptr = (T*)UnSafeGetPtr(&obj);
-            value = *ptr;
+            ::operator delete(copy, std::align_val_t(type.Align));
+            throw;
         }
+        type.Destruct(dst);
+        type.Relocate(copy, dst, 1);
+        ::operator delete(copy, std::align_val_t(type.Align));
     }
 
-#pragma endregion
-
-#pragma region Method Implementation
-
-    template <typename T>
-    const T* Method::GetAttribute() const
+    template<typename T>
+    void SoAVector<T>::Reallocate(size_t newCapacity)
     {
-        for (const std::shared_ptr<Attribute>& a : Attributes)
+        if (columns.empty())
+            columns = GetLayout();
+        for (Column& column : columns)
         {
-            if (IsA<T>(*a))
-                return Cast<T>(a.get());
+            // rounded so each column end on alignment too
+            size_t bytes = (newCapacity * column.Size + ColumnAlign - 1) & ~(ColumnAlign - 1);
+            std::byte* data = static_cast<std::byte*>(::operator new(bytes, std::align_val_t(ColumnAlign)));
+            if (column.Trivial)
+            {
+                if (size != 0)
+                    std::memcpy(data, column.Data, size * column.Size);
+            }
+            else
+            {
+                column.Type->Relocate(column.Data, data, size);
+            }
+            if (column.Data != nullptr)
+                ::operator delete(column.Data, std::align_val_t(ColumnAlign));
+            column.Data = data;
         }
-        return nullptr;
-    }
-
-    template <typename T>
-    const T* Method::HaveAttribute() const
-    {
-        return GetAttribute<T>() != nullptr;
+        capacity = newCapacity;
     }
 
-
-    // Arguments validation
     template<typename T>
-    void ValidateArgument(const Variable& argument, int index)
+    void SoAVector<T>::Release()
     {
-        if (argument.Declaration.IsPtr)
-        {
-            ETI_ASSERT(std::is_pointer_v<T>, "expected pointer argument");
-            ETI_ASSERT(IsA(TypeOf<T>(), *argument.Declaration.Type), "argument " << index << " must be of type: " << argument.Declaration.Type->Name << ", not " << TypeOf<T>().Name);
-        }
-        else if ( argument.Declaration.IsRef)
+        Clear();
+        for (Column& column : columns)
         {
-            ETI_ASSERT(std::is_pointer_v<T>, "expected pointer as arguments (for ref use pointer)");
-            ETI_ASSERT(IsA(TypeOf<T>(), *argument.Declaration.Type), "argument " << index << " must be of type: " << argument.Declaration.Type->Name << ", not " << TypeOf<T>().Name);
-        }
-        else
-        {
-            ETI_ASSERT(TypeOf<T>() == *argument.Declaration.Type, "argument " << index << " must be of type: " << argument.Declaration.Type->Name << ", not " << TypeOf<T>().Name);
+            if (column.Data != nullptr)
+                ::operator delete(column.Data, std::align_val_t(ColumnAlign));
+            column.Data = nullptr;
         }
+        capacity = 0;
     }
 
-    template<typename... Ts, std::size_t... Is>
-    void ValidateArgumentsForEach(std::span<const Variable> arguments, std::index_sequence<Is...>)
+#pragma endregion
+
+#pragma region Arena Implementation
+
+    inline Arena::~Arena()
     {
-        (ValidateArgument<Ts>(arguments[Is], Is), ...);
+        Reset();
+        for (Block& block : blocks)
+            ::operator delete(block.Data);
     }
 
-    template<typename... Args>
-    void ValidateArguments(std::span<const Variable> arguments)
+    inline void* Arena::Allocate(size_t size, size_t align)
     {
-        ETI_ASSERT(arguments.size() == sizeof...(Args), "argument count missmatch, method need " << arguments.size() << ", " << sizeof...(Args) << " provided");
-        ValidateArgumentsForEach<Args...>(arguments, std::index_sequence_for<Args...>{});
+        ETI_ASSERT(std::has_single_bit(align), "align should be a power of 2");
+
+        for (;;)
+        {
+            if (blockIndex == blocks.size())
+            {
+                // oversized allocation get their own block
+                size_t newSize = std::max(blockSize, size + align - 1);
+                blocks.push_back({ static_cast<std::byte*>(::operator new(newSize)), newSize });
+            }
+
+            Block& block = blocks[blockIndex];
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.Data);
+            size_t aligned = ((base + offset + align - 1) & ~(std::uintptr_t)(align - 1)) - base;
+            if (aligned + size <= block.Size)
+            {
+                usedSize += aligned + size - offset;
+                offset = aligned + size;
+                return block.Data + aligned;
+            }
+            ++blockIndex;
+            offset = 0;
+        }
     }
 
-    template <typename PARENT, typename RETURN, typename... ARGS>
-    void Method::CallMethod(PARENT& owner, RETURN* ret, ARGS... args) const
+    inline void* Arena::Construct(const Type& type)
     {
-        if (ret == nullptr)
-            ETI_ASSERT(Return->Declaration.Type->Kind == Kind::Void, "cannot provide return value on method returning void: " << Parent->Name << "::" << Name <<"()");
-        else
-            ETI_ASSERT(Return->Declaration.Type->Kind != Kind::Void, "missing return value on method with return: " << Parent->Name << "::" << Name <<"()");
+        ETI_ASSERT(type.HaveConstruct(), "type should be default constructible");
+        void* obj = Allocate(type.Size, type.Align);
+        type.Construct(obj);
+        if (!type.HaveFlag(TypeFlags::TriviallyDestructible))
+            destructs.push_back({ type.Destruct, obj });
+        return obj;
+    }
 
-        if (!IsLambda)
-            ValidateArguments<ARGS...>(Arguments);
+    inline void* Arena::CopyConstruct(const Type& type, const void* src)
+    {
+        ETI_ASSERT(type.HaveCopyConstruct(), "type should be copy constructible");
+        void* obj = Allocate(type.Size, type.Align);
+        if (type.HaveFlag(TypeFlags::TriviallyCopyable))
+            std::memcpy(obj, src, type.Size);
         else
-            ValidateArguments<PARENT*, ARGS...>(Arguments);
+            type.CopyConstruct(const_cast<void*>(src), obj);
+        if (!type.HaveFlag(TypeFlags::TriviallyDestructible))
+            destructs.push_back({ type.Destruct, obj });
+        return obj;
+    }
 
-        std::vector<void*> voidArgs = internal::GetVoidPtrFromArgs(args...);
+    template<typename T, typename... ARGS>
+    T* Arena::New(ARGS&&... args)
+    {
+        T* obj = new (Allocate(sizeof(T), alignof(T))) T(std::forward<ARGS>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            destructs.push_back({ utils::GetDestruct<T>(), obj });
+        return obj;
+    }
 
-        UnSafeCall(&owner, ret, voidArgs);
+    inline void Arena::Reset()
+    {
+        for (size_t i = destructs.size(); i-- > 0;)
+            destructs[i].Destruct(destructs[i].Object);
+        destructs.clear();
+        blockIndex = 0;
+        offset = 0;
+        usedSize = 0;
     }
-     
-    template <typename RETURN, typename... ARGS>
-    void Method::CallStaticMethod(RETURN* ret, ARGS... args) const
+
+    inline size_t Arena::GetCapacity() const
     {
-        if (ret == nullptr)
-            ETI_ASSERT(Return->Declaration.Type->Kind == Kind::Void, "cannot provide return value on method returning void: " << Parent->Name << "::" << Name <<"()");
-        else
-            ETI_ASSERT(Return->Declaration.Type->Kind != Kind::Void, "missing return value on method with return: %s::%s()" << Parent->Name << "::" << Name <<"()");
+        size_t capacity = 0;
+        for (const Block& block : blocks)
+            capacity += block.Size;
+        return capacity;
+    }
 
-        ValidateArguments<ARGS...>(Arguments);
+#pragma endregion
 
-        std::vector<void*> voidArgs = internal::GetVoidPtrFromArgs(args...);
+#if ETI_REPOSITORY
 
-        UnSafeCall(nullptr, ret, voidArgs);
-    }
+#pragma region Repository Implementation
 
-    inline void Method::UnSafeCall(void* obj, void* ret, std::span<void*> args) const
+    inline void Repository::Register(const Type& type)
     {
-        if (IsStatic)
-            ETI_ASSERT(obj == nullptr, "try to call static method on object instance");
-        else
-            ETI_ASSERT(obj != nullptr, "call member method without object instance");
+        // incomplete types, the complete type register itself
+        if (type.Kind == Kind::Forward)
+            return;
 
-        if (Return->Declaration.Type->Kind == Kind::Void)
-            ETI_ASSERT(ret == nullptr, "try to call method with no return value, but provided return argument is not nullptr");
-        else
-            ETI_ASSERT(ret != nullptr, "try to call method with return value, but provided return argument is nullptr");
+        std::lock_guard<std::recursive_mutex> lock(internal::GetTypesMutex());
 
-        if (IsLambda)
-        {
-            std::vector<void*> objArgs;
-            objArgs.push_back(&obj);
-            objArgs.insert(objArgs.end(), args.begin(), args.end());
-            this->Function(nullptr, ret, objArgs);
-        }
-        else
+        size_t chunk = type.Index / IndexChunkSize;
+        ETI_ASSERT(chunk < IndexChunkCount, "too many types, see Repository::IndexChunkCount");
+        IndexChunk* indexChunk = indices[chunk].load(std::memory_order_relaxed);
+        if (indexChunk == nullptr)
         {
-            this->Function(obj, ret, args);
+            indexChunks.push_back(std::make_unique<IndexChunk>());
+            indexChunk = indexChunks.back().get();
+            indices[chunk].store(indexChunk, std::memory_order_release);
         }
-    }
+        (*indexChunk)[type.Index % IndexChunkSize].store(&type, std::memory_order_release);
 
-#pragma endregion
+        // same type declared more than once (ex: same name in different namespaces) or TypeId collision keep first one,
+        // colliding ones are reported by AuditCollisions
+        if (GetType(type.Id) != nullptr)
+            return;
 
-#pragma region Type Implementation
+        const Table* table = ids.load(std::memory_order_relaxed);
+        if (table == nullptr || (GetTypeCount() + 1) * 2 > table->Slots.size())
+            Grow();
 
-    inline const Property* Type::GetProperty(std::string_view name) const
-    {
-        auto it = std::ranges::find_if(Properties, [name](const Property& it) { return it.Variable.Name == name; });
-        if (it != Properties.end())
-            return &*it;
-        if (Parent != nullptr)
-            return Parent->GetProperty(name);
-        return nullptr;
+        // current tables are the last ones pushed
+        Insert(*tables[tables.size() - 2], type.Id, &type);
+        Insert(*tables[tables.size() - 1], utils::GetStringHash(type.Name), &type);
+        count.fetch_add(1, std::memory_order_relaxed);
     }
 
-    inline const Property* Type::GetProperty(TypeId propertyId) const
+    inline const Type* Repository::GetType(TypeId id) const
     {
-        auto it = std::ranges::find_if(Properties, [propertyId](const Property& it) { return it.PropertyId == propertyId; });
-        if (it != Properties.end())
-            return &*it;
-        if (Parent != nullptr)
-            return Parent->GetProperty(propertyId);
-        return nullptr;
+        const Table* table = ids.load(std::memory_order_acquire);
+        if (table == nullptr)
+            return nullptr;
+        for (size_t index = internal::GetSlotIndex(id, table->Mask);; index = (index + 1) & table->Mask)
+        {
+            const Type* type = table->Slots[index].load(std::memory_order_acquire);
+            if (type == nullptr || type->Id == id)
+                return type;
+        }
     }
 
-    inline const Method* Type::GetMethod(std::string_view name) const
+    inline const Type* Repository::GetType(std::string_view name) const
     {
-        auto it = std::ranges::find_if(Methods, [name](const Method& it) { return it.Name == name; });
-        if (it != Methods.end())
-            return &*it;
-        if (Parent != nullptr)
-            return Parent->GetMethod(name);
-        return nullptr;
+        const Table* table = names.load(std::memory_order_acquire);
+        if (table == nullptr)
+            return nullptr;
+        for (size_t index = internal::GetSlotIndex(utils::GetStringHash(name), table->Mask);; index = (index + 1) & table->Mask)
+        {
+            const Type* type = table->Slots[index].load(std::memory_order_acquire);
+            if (type == nullptr || type->Name == name)
+                return type;
+        }
     }
 
-    inline const Method* Type::GetMethod(TypeId methodId) const
+    inline const Type* Repository::GetTypeByIndex(size_t index) const
     {
-        auto it = std::ranges::find_if(Methods, [methodId](const Method& it) { return it.MethodId == methodId; });
-        if (it != Methods.end())
-            return &*it;
-        if (Parent != nullptr)
-            return Parent->GetMethod(methodId);
-        return nullptr;
+        if (index >= IndexChunkSize * IndexChunkCount)
+            return nullptr;
+        const IndexChunk* chunk = indices[index / IndexChunkSize].load(std::memory_order_acquire);
+        return chunk != nullptr ? (*chunk)[index % IndexChunkSize].load(std::memory_order_acquire) : nullptr;
     }
 
-    template <typename T>
-    const T* Type::GetAttribute() const
+    namespace internal
     {
-        for (const std::shared_ptr<Attribute>& a : Attributes)
+        // sorted by id, adjacent entries with same id and different names collide
+        inline void AppendCollisions(std::vector<std::pair<TypeId, std::string_view>>& entries, const Type* owner, std::vector<IdCollision>& collisions)
         {
-            if (IsA<T>(*a))
-                return Cast<T>(a.get());
+            std::ranges::sort(entries);
+            for (size_t i = 1; i < entries.size(); ++i)
+            {
+                if (entries[i].first == entries[i - 1].first && entries[i].second != entries[i - 1].second)
+                    collisions.push_back({ entries[i].first, entries[i - 1].second, entries[i].second, owner });
+            }
         }
-        return nullptr;
-    }
-
-    template <typename T>
-    const T* Type::HaveAttribute() const
-    {
-        return GetAttribute<T>() != nullptr;
     }
 
-    inline std::size_t Type::GetEnumValue(std::string_view enumName) const
+    inline std::vector<IdCollision> Repository::AuditCollisions() const
     {
-        for( size_t i = 0; i < EnumSize; ++i )
+        std::vector<IdCollision> collisions;
+        std::vector<std::pair<TypeId, std::string_view>> types;
+        std::vector<std::pair<TypeId, std::string_view>> members;
+        for (size_t index = 0; index < GetTypeIndexCount(); ++index)
         {
-            if (GetEnumValueName(i) == enumName)
-                return i;
+            const Type* type = GetTypeByIndex(index);
+            if (type == nullptr)
+                continue;
+            types.emplace_back(type->Id, type->Name);
+
+            members.clear();
+            for (const Type* owner = type; owner != nullptr; owner = owner->Parent)
+            {
+                for (const Property& property : owner->Properties)
+                    members.emplace_back(property.PropertyId, property.Variable.Name);
+            }
+            internal::AppendCollisions(members, type, collisions);
+
+            members.clear();
+            for (const Type* owner = type; owner != nullptr; owner = owner->Parent)
+            {
+                for (const Method& method : owner->Methods)
+                    members.emplace_back(method.MethodId, method.Name);
+            }
+            internal::AppendCollisions(members, type, collisions);
+
+            members.clear();
+            for (const EnumEntry& entry : type->EnumEntries)
+                members.emplace_back(utils::GetStringHash(entry.Name), entry.Name);
+            internal::AppendCollisions(members, type, collisions);
         }
-        return InvalidIndex;
+        internal::AppendCollisions(types, nullptr, collisions);
+        return collisions;
     }
 
-    inline std::string_view Type::GetEnumValueName(size_t enumValue) const
+    inline void Repository::Insert(Table& table, TypeId key, const Type* type)
     {
-        ETI_ASSERT(Kind == Kind::Enum, "GetEnumValueName should be only called with enum");
-        return internal::GetEnumNameWithOffset(EnumNames, enumValue, 0);
+        size_t index = internal::GetSlotIndex(key, table.Mask);
+        while (table.Slots[index].load(std::memory_order_relaxed) != nullptr)
+            index = (index + 1) & table.Mask;
+        table.Slots[index].store(type, std::memory_order_release);
     }
 
-    inline TypeId Type::GetEnumValueHash(std::size_t enumValue) const
+    // tables are rebuilt before being published, readers see old or new tables, never partial ones
+    inline void Repository::Grow()
     {
-        ETI_ASSERT(Kind == Kind::Enum, "GetEnumValueHash should be only called with enum");
-        return ETI_HASH_FUNCTION(GetEnumValueName(enumValue));
-    }
+        const Table* oldIds = ids.load(std::memory_order_relaxed);
+        size_t capacity = oldIds != nullptr ? oldIds->Slots.size() * 2 : 256;
+
+        std::unique_ptr<Table> newIds = std::make_unique<Table>(capacity);
+        std::unique_ptr<Table> newNames = std::make_unique<Table>(capacity);
+        if (oldIds != nullptr)
+        {
+            for (const std::atomic<const Type*>& slot : oldIds->Slots)
+            {
+                if (const Type* type = slot.load(std::memory_order_relaxed))
+                {
+                    Insert(*newIds, type->Id, type);
+                    Insert(*newNames, utils::GetStringHash(type->Name), type);
+                }
+            }
+        }
 
+        ids.store(newIds.get(), std::memory_order_release);
+        names.store(newNames.get(), std::memory_order_release);
+        tables.push_back(std::move(newIds));
+        tables.push_back(std::move(newNames));
+    }
 
 #pragma endregion
 
+#endif // #if ETI_REPOSITORY
+
 #pragma region Global Implementation
 
     // default impl of TypeOfImpl::GetTypeStatic(), should be specialized
@@ -1799,8 +4034,11 @@ namespace eti
     template<typename T>
     const Type& TypeOfImpl<T>::GetTypeStatic()
     {
-            static Type type = internal::MakeType<T>(Kind::Unknown, nullptr, {}, {}, {});
-            return type;
+        static constinit internal::TypeStorage storage;
+        return internal::GetOrInitializeType(storage, []()
+        {
+            return internal::MakeType<T>(Kind::Unknown, nullptr, {}, {}, {});
+        });
     }
 
     template<typename T>
@@ -1816,16 +4054,15 @@ namespace eti
         return internal::OwnerGetType<T>();
     }
 
+    inline size_t GetTypeIndexCount()
+    {
+        return internal::GetTypeIndexCounter().load(std::memory_order_relaxed);
+    }
+
+    // constant time, check base Id is at base depth in type ancestors display
     inline constexpr bool IsA(const Type& type, const Type& base)
     {
-        const Type* cur = &type;
-        while (cur != nullptr)
-        {
-            if (*cur == base)
-                return true;
-            cur = cur->Parent;
-        }
-        return false;
+        return base.Depth < type.Ancestors.size() && type.Ancestors[base.Depth] == base.Id;
     }
 
     template<typename BASE, typename T>
@@ -1927,6 +4164,27 @@ namespace eti
         Access Access = Access::Unknown;
     };
 
+    // container kind of reflected std::vector/std::map (see declarations at the end), used by serializers
+    enum class ContainerKind : std::uint8_t
+    {
+        Vector,     // methods: GetSize, GetData, Resize
+        Map         // methods: GetSize, Visit, InsertDefault, Clear
+    };
+
+    class Container : public Attribute
+    {
+        ETI_CLASS(Container, Attribute)
+
+    public:
+
+        Container(ContainerKind kind)
+        {
+            Kind = kind;
+        }
+
+        ContainerKind Kind = ContainerKind::Vector;
+    };
+
 #pragma endregion
 
  }
@@ -2086,6 +4344,18 @@ namespace eti::utils
             keys.push_back(key);
         }
     }
+
+    // type erased map iteration, called for each key/value
+    using MapVisitFunction = void (*)(void* /* context */, const void* /* key */, void* /* value */);
+
+    template<typename KEY,typename VALUE>
+    void MapVisit(std::map<KEY,VALUE>& map, MapVisitFunction visit, void* context)
+    {
+        for( auto& [key, value] : map)
+        {
+            visit(context, &key, &value);
+        }
+    }
 }
 
 ETI_BASE_EXTERNAL(std::string, ETI_PROPERTIES(), ETI_METHODS())
@@ -2109,8 +4379,11 @@ ETI_EXTERNAL_BASE_T1
         ETI_METHOD_LAMBDA(RemoveAt, [](std::vector<T1>& vector, size_t index) { eti::utils::VectorRemoveAt(vector, index); }),
         ETI_METHOD_LAMBDA(RemoveAtSwap, [](std::vector<T1>& vector, size_t index) { eti::utils::VectorRemoveAtSwap(vector, index); }),
         ETI_METHOD_LAMBDA(Clear, [](std::vector<T1>& vector) { vector.clear(); }),
-        ETI_METHOD_LAMBDA(Reserve, [](std::vector<T1>& vector, size_t size) { vector.reserve(size); })
-    )
+        ETI_METHOD_LAMBDA(Reserve, [](std::vector<T1>& vector, size_t size) { vector.reserve(size); }),
+        ETI_METHOD_LAMBDA(Resize, [](std::vector<T1>& vector, size_t size) { vector.resize(size); }),
+        ETI_METHOD_LAMBDA(GetData, [](std::vector<T1>& vector) { return vector.data(); })
+    ),
+    ::eti::Container(::eti::ContainerKind::Vector)
 )
 
 // declare map type with common methods
@@ -2130,7 +4403,9 @@ ETI_EXTERNAL_BASE_T2
         ETI_METHOD_LAMBDA(Remove, [](std::map<T1,T2>& map, const T1& key) -> bool { return eti::utils::MapRemove(map, key); }),
         ETI_METHOD_LAMBDA(Clear, [](std::map<T1,T2>& map) { map.clear(); }),
         ETI_METHOD_LAMBDA(GetKeys, [](std::map<T1,T2>& map, std::vector<T1>& keys) { eti::utils::MapGetKeys(map, keys); }),
-    )
+        ETI_METHOD_LAMBDA(Visit, [](std::map<T1,T2>& map, eti::utils::MapVisitFunction visit, void* context) { eti::utils::MapVisit(map, visit, context); }),
+    ),
+    ::eti::Container(::eti::ContainerKind::Map)
 )
 
 #endif // #if ETI_COMMON_TYPE
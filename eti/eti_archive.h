@@ -0,0 +1,677 @@
+//  MIT License
+//
+//  Copyright (c) 2024 Eric Thiffeault
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// https://github.com/ethiffeault/eti
+
+#pragma once
+
+// zero copy archive of reflected types, read in place from memory (ex: mapped file)
+//
+//  objects are stored as images of their memory layout (Type::Size, Type::Align, property offsets),
+//  serialized members (see binary::Plan) are copied, everything else (pointers, padding, vtable) is zero.
+//  std::string, std::wstring, std::vector and std::map members are replaced by a RelativeSpan
+//  pointing to their elements (also images) elsewhere in the archive.
+//
+//  layout:
+//      Header
+//      object images and their elements
+//      TypeEntry[TypeCount]: TypeId and binary::Plan::LayoutHash of every type having an image
+//      ObjectEntry[ObjectCount]: root objects
+//
+//  format is native (endianness, pod size), an archive with a changed type layout is rejected
+
+#include <cstring>
+#include <map>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <eti/eti.h>
+#include <eti/eti_binary.h>
+
+#if !ETI_REPOSITORY
+    #error eti_archive.h need ETI_REPOSITORY (archive types are resolved by TypeId)
+#endif
+
+namespace eti
+{
+
+#pragma region Archive Format
+
+    namespace archive
+    {
+        constexpr std::uint32_t Magic = 0x41495445; // "ETIA"
+        constexpr std::uint32_t Version = 1;
+
+        struct Header
+        {
+            std::uint32_t Magic = 0;
+            std::uint32_t Version = 0;
+            std::uint64_t Size = 0;
+            std::uint64_t TypesOffset = 0;
+            std::uint64_t TypeCount = 0;
+            std::uint64_t ObjectsOffset = 0;
+            std::uint64_t ObjectCount = 0;
+        };
+
+        struct TypeEntry
+        {
+            TypeId Id = 0;
+            std::uint64_t LayoutHash = 0;
+            std::uint64_t Size = 0;
+            std::uint64_t Align = 0;
+        };
+
+        struct ObjectEntry
+        {
+            std::uint64_t Type = 0; // index in type entries
+            std::uint64_t Offset = 0;
+        };
+
+        // image of string, vector and map members, Offset is relative to RelativeSpan address, Size is element count
+        // map: keys at Offset, values follow (aligned)
+        struct RelativeSpan
+        {
+            std::int64_t Offset = 0;
+            std::uint64_t Size = 0;
+        };
+
+        static_assert(sizeof(std::string) >= sizeof(RelativeSpan) && sizeof(std::wstring) >= sizeof(RelativeSpan), "string too small to hold a RelativeSpan");
+        static_assert(sizeof(std::vector<int>) >= sizeof(RelativeSpan) && sizeof(std::map<int, int>) >= sizeof(RelativeSpan), "container too small to hold a RelativeSpan");
+
+        inline std::uint64_t AlignUp(std::uint64_t offset, std::uint64_t align)
+        {
+            return (offset + align - 1) & ~(align - 1);
+        }
+
+        // image is the object itself (only copy steps, ex: pods, enums and struct of them)
+        inline bool IsInPlace(const Type& type)
+        {
+            for (const binary::Step& step : binary::GetPlan(type).Steps)
+            {
+                if (step.Kind != binary::StepKind::Copy)
+                    return false;
+            }
+            return true;
+        }
+
+        template<typename T>
+        bool IsInPlace()
+        {
+            static const bool inPlace = IsInPlace(TypeOf<T>());
+            return inPlace;
+        }
+    }
+
+#pragma endregion
+
+#pragma region Archive Writer
+
+    class ArchiveWriter
+    {
+    public:
+
+        ArchiveWriter() { Clear(); }
+
+        // append a root object, return its index
+        template<typename T>
+        size_t Write(const T& obj)
+        {
+            return WriteObject(TypeOf<T>(), &obj);
+        }
+
+        size_t WriteObject(const Type& type, const void* obj)
+        {
+            ETI_ASSERT(!finished, "ArchiveWriter::Finish already called, Clear first");
+            const binary::Plan& plan = binary::GetPlan(type);
+            std::uint64_t offset = Allocate(type.Size, type.Align);
+            WriteImage(plan, obj, offset);
+            objects.push_back({ AddType(type), offset });
+            return objects.size() - 1;
+        }
+
+        // append type and object tables, buffer is a complete archive
+        std::span<const std::byte> Finish()
+        {
+            if (!finished)
+            {
+                archive::Header header;
+                header.Magic = archive::Magic;
+                header.Version = archive::Version;
+                header.TypesOffset = Allocate(types.size() * sizeof(archive::TypeEntry), alignof(archive::TypeEntry));
+                header.TypeCount = types.size();
+                if (!types.empty())
+                    std::memcpy(buffer.data() + header.TypesOffset, types.data(), types.size() * sizeof(archive::TypeEntry));
+                header.ObjectsOffset = Allocate(objects.size() * sizeof(archive::ObjectEntry), alignof(archive::ObjectEntry));
+                header.ObjectCount = objects.size();
+                if (!objects.empty())
+                    std::memcpy(buffer.data() + header.ObjectsOffset, objects.data(), objects.size() * sizeof(archive::ObjectEntry));
+                header.Size = buffer.size();
+                std::memcpy(buffer.data(), &header, sizeof(header));
+                finished = true;
+            }
+            return buffer;
+        }
+
+        std::span<const std::byte> GetBuffer() const { return buffer; }
+
+        void Clear()
+        {
+            buffer.assign(sizeof(archive::Header), std::byte(0));
+            types.clear();
+            typeIndices.clear();
+            objects.clear();
+            finished = false;
+        }
+
+    private:
+
+        // zeroed bytes at aligned offset (from buffer start)
+        std::uint64_t Allocate(size_t size, size_t align)
+        {
+            std::uint64_t offset = archive::AlignUp(buffer.size(), align);
+            buffer.resize(offset + size);
+            return offset;
+        }
+
+        std::uint64_t AddType(const Type& type)
+        {
+            auto [it, inserted] = typeIndices.try_emplace(&type, types.size());
+            if (inserted)
+                types.push_back({ type.Id, binary::GetPlan(type).LayoutHash, type.Size, type.Align });
+            return it->second;
+        }
+
+        void WriteSpan(std::uint64_t memberOffset, std::uint64_t offset, size_t size)
+        {
+            archive::RelativeSpan span = { (std::int64_t)offset - (std::int64_t)memberOffset, size };
+            std::memcpy(buffer.data() + memberOffset, &span, sizeof(span));
+        }
+
+        // buffer grows while writing, only offsets are kept
+        void WriteImage(const binary::Plan& plan, const void* obj, std::uint64_t offset)
+        {
+            const std::byte* bytes = static_cast<const std::byte*>(obj);
+            for (const binary::Step& step : plan.Steps)
+            {
+                const std::byte* member = bytes + step.Offset;
+                std::uint64_t memberOffset = offset + step.Offset;
+                switch (step.Kind)
+                {
+                    case binary::StepKind::Copy:
+                        std::memcpy(buffer.data() + memberOffset, member, step.Size);
+                        break;
+                    case binary::StepKind::String:
+                        WriteString(*reinterpret_cast<const std::string*>(member), memberOffset);
+                        break;
+                    case binary::StepKind::WString:
+                        WriteString(*reinterpret_cast<const std::wstring*>(member), memberOffset);
+                        break;
+                    case binary::StepKind::Vector:
+                        WriteVector(step, const_cast<std::byte*>(member), memberOffset);
+                        break;
+                    case binary::StepKind::Map:
+                        WriteMap(step, const_cast<std::byte*>(member), memberOffset);
+                        break;
+                }
+            }
+        }
+
+        template<typename STRING>
+        void WriteString(const STRING& str, std::uint64_t memberOffset)
+        {
+            using Char = typename STRING::value_type;
+            std::uint64_t offset = Allocate(str.size() * sizeof(Char), alignof(Char));
+            if (!str.empty())
+                std::memcpy(buffer.data() + offset, str.data(), str.size() * sizeof(Char));
+            WriteSpan(memberOffset, offset, str.size());
+        }
+
+        void WriteElements(const binary::Plan& plan, const std::byte* data, size_t size, std::uint64_t offset)
+        {
+            size_t elementSize = plan.Type->Size;
+            if (plan.IsTrivial)
+            {
+                if (size != 0)
+                    std::memcpy(buffer.data() + offset, data, size * elementSize);
+                return;
+            }
+            for (size_t i = 0; i < size; ++i)
+                WriteImage(plan, data + i * elementSize, offset + i * elementSize);
+        }
+
+        void WriteVector(const binary::Step& step, void* vector, std::uint64_t memberOffset)
+        {
+            size_t size = 0;
+            std::byte* data = nullptr;
+            step.GetSize->UnSafeCall(vector, &size, {});
+            step.Access->UnSafeCall(vector, &data, {});
+
+            const Type& elementType = *step.Element->Type;
+            AddType(elementType);
+            std::uint64_t offset = Allocate(size * elementType.Size, elementType.Align);
+            WriteElements(*step.Element, data, size, offset);
+            WriteSpan(memberOffset, offset, size);
+        }
+
+        struct MapVisitContext
+        {
+            ArchiveWriter* Writer;
+            const binary::Step* Step;
+            std::uint64_t Keys;
+            std::uint64_t Values;
+            size_t Index;
+        };
+
+        void WriteMap(const binary::Step& step, void* map, std::uint64_t memberOffset)
+        {
+            size_t size = 0;
+            step.GetSize->UnSafeCall(map, &size, {});
+
+            const Type& keyType = *step.KeyType;
+            const Type& valueType = *step.Element->Type;
+            AddType(keyType);
+            AddType(valueType);
+
+            // keys then values, single block
+            std::uint64_t keys = Allocate(size * keyType.Size, keyType.Align);
+            std::uint64_t values = Allocate(size * valueType.Size, valueType.Align);
+            WriteSpan(memberOffset, keys, size);
+
+            MapVisitContext context = { this, &step, keys, values, 0 };
+            utils::MapVisitFunction visit = [](void* context, const void* key, void* value)
+            {
+                MapVisitContext& visitContext = *static_cast<MapVisitContext*>(context);
+                const binary::Step& step = *visitContext.Step;
+                ArchiveWriter& writer = *visitContext.Writer;
+                writer.WriteImage(*step.Key, key, visitContext.Keys + visitContext.Index * step.KeyType->Size);
+                writer.WriteImage(*step.Element, value, visitContext.Values + visitContext.Index * step.Element->Type->Size);
+                ++visitContext.Index;
+            };
+            void* contextPtr = &context;
+            void* visitArgs[] = { &visit, &contextPtr };
+            step.Access->UnSafeCall(map, NoReturn, visitArgs);
+        }
+
+        std::vector<std::byte> buffer;
+        std::vector<archive::TypeEntry> types;
+        std::map<const Type*, std::uint64_t> typeIndices;
+        std::vector<archive::ObjectEntry> objects;
+        bool finished = false;
+    };
+
+#pragma endregion
+
+#pragma region Archive Views
+
+    class Archive;
+    class ArrayView;
+    class MapView;
+
+    // object image in archive, invalid view (IsValid() == false) on type mismatch or corrupted offsets
+    class ObjectView
+    {
+    public:
+
+        ObjectView() = default;
+        ObjectView(const Archive* archive, const Type* type, const std::byte* data)
+            : archive(archive), type(type), data(data) {}
+
+        bool IsValid() const { return data != nullptr; }
+        const Type* GetType() const { return type; }
+        const void* GetData() const { return data; }
+
+        // pointer in archive, T must be view type and in place (see archive::IsInPlace)
+        template<typename T>
+        const T* As() const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be used in place");
+            if (data == nullptr || *type != TypeOf<T>() || !archive::IsInPlace<T>())
+                return nullptr;
+            return reinterpret_cast<const T*>(data);
+        }
+
+        std::string_view AsString() const { return AsChars<char>(); }
+        std::wstring_view AsWString() const { return AsChars<wchar_t>(); }
+        ArrayView AsArray() const;
+        MapView AsMap() const;
+
+        // value property (own or inherited) of this object
+        ObjectView GetMember(const Property& property) const
+        {
+            if (data == nullptr || !property.Variable.Declaration.IsValue || !IsA(*type, property.Parent))
+                return {};
+            return { archive, property.Variable.Declaration.Type, data + property.Offset };
+        }
+
+        ObjectView GetMember(std::string_view name) const
+        {
+            const Property* property = data != nullptr ? type->GetProperty(name) : nullptr;
+            return property != nullptr ? GetMember(*property) : ObjectView();
+        }
+
+        template<typename T>
+        const T* Get(std::string_view name) const
+        {
+            return GetMember(name).template As<T>();
+        }
+
+    private:
+
+        template<typename CHAR>
+        std::basic_string_view<CHAR> AsChars() const;
+
+        const Archive* archive = nullptr;
+        const Type* type = nullptr;
+        const std::byte* data = nullptr;
+    };
+
+    // contiguous element images (vector elements, map keys or values)
+    class ArrayView
+    {
+    public:
+
+        ArrayView() = default;
+        ArrayView(const Archive* archive, const Type* type, const std::byte* data, size_t size)
+            : archive(archive), type(type), data(data), size(size) {}
+
+        bool IsValid() const { return data != nullptr; }
+        const Type* GetType() const { return type; }
+        size_t GetSize() const { return size; }
+
+        ObjectView operator[](size_t index) const
+        {
+            ETI_ASSERT(index < size, "ArrayView index out of range");
+            return { archive, type, data + index * type->Size };
+        }
+
+        // elements in archive, T must be element type and in place (see archive::IsInPlace)
+        template<typename T>
+        std::span<const T> As() const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be used in place");
+            if (data == nullptr || *type != TypeOf<T>() || !archive::IsInPlace<T>())
+                return {};
+            return { reinterpret_cast<const T*>(data), size };
+        }
+
+    private:
+        const Archive* archive = nullptr;
+        const Type* type = nullptr;
+        const std::byte* data = nullptr;
+        size_t size = 0;
+    };
+
+    // keys in std::map order, Values[i] is value of Keys[i]
+    class MapView
+    {
+    public:
+
+        MapView() = default;
+        MapView(ArrayView keys, ArrayView values)
+            : Keys(keys), Values(values) {}
+
+        bool IsValid() const { return Keys.IsValid(); }
+        size_t GetSize() const { return Keys.GetSize(); }
+
+        ArrayView Keys;
+        ArrayView Values;
+    };
+
+#pragma endregion
+
+#pragma region Archive Reader
+
+    // read archive written by ArchiveWriter in place, data must outlive archive and views (see MappedFile)
+    class Archive
+    {
+    public:
+
+        // false if data is not a valid archive, or a type is not registered (see Repository) or have a different layout
+        bool Open(std::span<const std::byte> archiveData)
+        {
+            data = {};
+            objects = {};
+            types.clear();
+
+            archive::Header header;
+            if (archiveData.size() < sizeof(header) || (std::uintptr_t)archiveData.data() % alignof(archive::Header) != 0)
+                return false;
+            std::memcpy(&header, archiveData.data(), sizeof(header));
+            if (header.Magic != archive::Magic || header.Version != archive::Version || header.Size != archiveData.size())
+                return false;
+            if (!IsTable(header.TypesOffset, header.TypeCount, sizeof(archive::TypeEntry), archiveData.size()) ||
+                !IsTable(header.ObjectsOffset, header.ObjectCount, sizeof(archive::ObjectEntry), archiveData.size()))
+                return false;
+
+            const archive::TypeEntry* typeEntries = reinterpret_cast<const archive::TypeEntry*>(archiveData.data() + header.TypesOffset);
+            for (size_t i = 0; i < header.TypeCount; ++i)
+            {
+                const archive::TypeEntry& entry = typeEntries[i];
+                const Type* type = Repository::Instance().GetType(entry.Id);
+                if (type == nullptr || type->Size != entry.Size || type->Align != entry.Align || binary::GetPlan(*type).LayoutHash != entry.LayoutHash)
+                    return false;
+                // images are aligned from archive start
+                if ((std::uintptr_t)archiveData.data() % type->Align != 0)
+                    return false;
+                types.push_back(type);
+            }
+
+            const archive::ObjectEntry* objectEntries = reinterpret_cast<const archive::ObjectEntry*>(archiveData.data() + header.ObjectsOffset);
+            for (size_t i = 0; i < header.ObjectCount; ++i)
+            {
+                const archive::ObjectEntry& entry = objectEntries[i];
+                if (entry.Type >= types.size() || !IsTable(entry.Offset, 1, types[entry.Type]->Size, archiveData.size()) || entry.Offset % types[entry.Type]->Align != 0)
+                    return false;
+            }
+
+            data = archiveData;
+            objects = { objectEntries, (size_t)header.ObjectCount };
+            return true;
+        }
+
+        size_t GetObjectCount() const { return objects.size(); }
+
+        ObjectView GetObject(size_t index) const
+        {
+            ETI_ASSERT(index < objects.size(), "Archive object index out of range");
+            const archive::ObjectEntry& entry = objects[index];
+            return { this, types[entry.Type], data.data() + entry.Offset };
+        }
+
+        template<typename T>
+        const T* Get(size_t index) const
+        {
+            return GetObject(index).template As<T>();
+        }
+
+        // RelativeSpan at member to count elements, nullptr if out of archive or misaligned
+        const std::byte* Resolve(const std::byte* member, size_t elementSize, size_t align, size_t& count) const
+        {
+            archive::RelativeSpan span;
+            std::memcpy(&span, member, sizeof(span));
+            std::uint64_t offset = (std::uint64_t)(member - data.data()) + (std::uint64_t)span.Offset;
+            if (!IsTable(offset, span.Size, elementSize, data.size()) || offset % align != 0)
+                return nullptr;
+            count = (size_t)span.Size;
+            return data.data() + offset;
+        }
+
+        // count elements following end (aligned), nullptr if out of archive
+        const std::byte* ResolveNext(const std::byte* end, size_t elementSize, size_t align, size_t count) const
+        {
+            std::uint64_t offset = archive::AlignUp((std::uint64_t)(end - data.data()), align);
+            if (!IsTable(offset, count, elementSize, data.size()))
+                return nullptr;
+            return data.data() + offset;
+        }
+
+    private:
+
+        // count elements of size at offset fit in archive (overflow safe)
+        static bool IsTable(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t archiveSize)
+        {
+            return offset <= archiveSize && (size == 0 || count <= (archiveSize - offset) / size);
+        }
+
+        std::span<const std::byte> data;
+        std::span<const archive::ObjectEntry> objects;
+        std::vector<const Type*> types;
+    };
+
+    template<typename CHAR>
+    std::basic_string_view<CHAR> ObjectView::AsChars() const
+    {
+        using StringType = std::basic_string<CHAR>;
+        if (data == nullptr || *type != TypeOf<StringType>())
+            return {};
+        size_t size = 0;
+        const std::byte* chars = archive->Resolve(data, sizeof(CHAR), alignof(CHAR), size);
+        if (chars == nullptr)
+            return {};
+        return { reinterpret_cast<const CHAR*>(chars), size };
+    }
+
+    inline ArrayView ObjectView::AsArray() const
+    {
+        const Container* container = data != nullptr ? type->GetAttribute<Container>() : nullptr;
+        if (container == nullptr || container->Kind != ContainerKind::Vector)
+            return {};
+        const Type* elementType = type->Templates[0].Type;
+        size_t size = 0;
+        const std::byte* elements = archive->Resolve(data, elementType->Size, elementType->Align, size);
+        if (elements == nullptr)
+            return {};
+        return { archive, elementType, elements, size };
+    }
+
+    inline MapView ObjectView::AsMap() const
+    {
+        const Container* container = data != nullptr ? type->GetAttribute<Container>() : nullptr;
+        if (container == nullptr || container->Kind != ContainerKind::Map)
+            return {};
+        const Type* keyType = type->Templates[0].Type;
+        const Type* valueType = type->Templates[1].Type;
+        size_t size = 0;
+        const std::byte* keys = archive->Resolve(data, keyType->Size, keyType->Align, size);
+        if (keys == nullptr)
+            return {};
+
+        // values follow keys (see ArchiveWriter::WriteMap)
+        const std::byte* values = archive->ResolveNext(keys + size * keyType->Size, valueType->Size, valueType->Align, size);
+        if (values == nullptr)
+            return {};
+        return { ArrayView(archive, keyType, keys, size), ArrayView(archive, valueType, values, size) };
+    }
+
+#pragma endregion
+
+#pragma region Mapped File
+
+    // read only file mapping, pages are loaded on access
+    class MappedFile
+    {
+    public:
+
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile() { Close(); }
+
+        // false if file can't be opened or is empty
+        bool Open(const char* path)
+        {
+            Close();
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER fileSize;
+            HANDLE mapping = nullptr;
+            if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            // view keep the mapping alive
+            void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (mapping != nullptr)
+                CloseHandle(mapping);
+            CloseHandle(file);
+            if (view == nullptr)
+                return false;
+            data = static_cast<const std::byte*>(view);
+            size = (size_t)fileSize.QuadPart;
+#else
+            int file = open(path, O_RDONLY);
+            if (file < 0)
+                return false;
+            struct stat fileStat;
+            void* view = MAP_FAILED;
+            if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+                view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            // mapping stay valid once file is closed
+            close(file);
+            if (view == MAP_FAILED)
+                return false;
+            data = static_cast<const std::byte*>(view);
+            size = (size_t)fileStat.st_size;
+#endif
+            return true;
+        }
+
+        void Close()
+        {
+            if (data == nullptr)
+                return;
+#if defined(_WIN32)
+            UnmapViewOfFile(data);
+#else
+            munmap(const_cast<std::byte*>(data), size);
+#endif
+            data = nullptr;
+            size = 0;
+        }
+
+        bool IsOpen() const { return data != nullptr; }
+        std::span<const std::byte> GetData() const { return { data, size }; }
+
+    private:
+        const std::byte* data = nullptr;
+        size_t size = 0;
+    };
+
+#pragma endregion
+
+}
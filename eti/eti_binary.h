@@ -0,0 +1,1008 @@
+//  MIT License
+//
+//  Copyright (c) 2024 Eric Thiffeault
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// https://github.com/ethiffeault/eti
+
+#pragma once
+
+// binary serialization of reflected types
+//
+//  each Type get a flattened plan (once): properties (own, inherited and nested struct ones) are
+//  converted to steps at object offsets, adjacent pod/enum fields are merged in single memcpy,
+//  std::string/std::wstring and reflected std::vector/std::map are variable length blocks.
+//
+//  each object is preceded by its plan LayoutHash and schema size, the first object of a layout also have
+//  its schema (fields id, kind and declared type), data written with another layout is read with a
+//  migration: fields are matched by property path, removed ones are skipped, new ones get default value.
+//
+//  format is native (endianness, pod size), use it to checkpoint/restore on same platform
+
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <eti/eti.h>
+
+namespace eti
+{
+
+#pragma region Binary Plan
+
+    namespace binary
+    {
+        enum class StepKind : std::uint8_t
+        {
+            Copy,       // memcpy Size bytes at Offset
+            String,     // std::string
+            WString,    // std::wstring
+            Vector,     // reflected std::vector, size then elements
+            Map         // reflected std::map, size then key/value pairs
+        };
+
+        struct Plan;
+
+        struct Step
+        {
+            StepKind Kind = StepKind::Copy;
+            size_t Offset = 0;
+            // Copy: bytes, String/WString: char size
+            size_t Size = 0;
+
+            // Vector: element plan and stride, Map: value plan
+            const Plan* Element = nullptr;
+            size_t ElementSize = 0;
+            // Map: key type and plan
+            const Type* KeyType = nullptr;
+            const Plan* Key = nullptr;
+
+            // container methods, Vector: GetSize, GetData, Resize, Map: GetSize, Visit, InsertDefaultOrGet, Clear
+            const Method* GetSize = nullptr;
+            const Method* Access = nullptr;
+            const Method* Insert = nullptr;
+            const Method* Clear = nullptr;
+
+            // fields only: hash of property names path (ex: Origin.X) and declared type
+            std::uint64_t Id = 0;
+            const Type* FieldType = nullptr;
+        };
+
+        struct Plan
+        {
+            const Type* Type = nullptr;
+            // single step per serialized member, in serialization order
+            std::vector<Step> Fields;
+            // Fields with adjacent Copy merged
+            std::vector<Step> Steps;
+            // single memcpy of whole object (no padding, no variable length member)
+            bool IsTrivial = false;
+            // smallest written size (variable length members count their size), bound element counts on read
+            size_t MinSize = 0;
+            // hash of serialized layout: size, align, fields (id, declared type, offset) and container elements layout
+            std::uint64_t LayoutHash = 0;
+        };
+
+        const Plan& GetPlan(const Type& type);
+
+        namespace internal
+        {
+            constexpr std::uint64_t HashSeed = 0xcbf29ce484222325ull;
+
+            // fnv1 over value bytes
+            template<typename T>
+            std::uint64_t HashValue(std::uint64_t hash, const T& value)
+            {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+                for (size_t i = 0; i < sizeof(T); ++i)
+                {
+                    hash ^= bytes[i];
+                    hash *= 0x100000001B3ull;
+                }
+                return hash;
+            }
+
+            inline void AppendCopy(std::vector<Step>& steps, size_t offset, size_t size)
+            {
+                if (size == 0)
+                    return;
+                if (!steps.empty() && steps.back().Kind == StepKind::Copy && steps.back().Offset + steps.back().Size == offset)
+                    steps.back().Size += size;
+                else
+                    steps.push_back({ StepKind::Copy, offset, size });
+            }
+
+            const Plan& GetPlanLocked(const Type& type);
+
+            // append fields of type at offset, nested structs are flattened (id is the property path hash)
+            inline void AppendFields(std::vector<Step>& fields, const Type& type, size_t offset, std::uint64_t id)
+            {
+                Step field;
+                field.Offset = offset;
+                field.Id = id;
+                field.FieldType = &type;
+                if (type.Kind == Kind::Pod || type.Kind == Kind::Enum)
+                {
+                    field.Kind = StepKind::Copy;
+                    field.Size = type.Size;
+                    fields.push_back(field);
+                }
+                else if (type == TypeOf<std::string>())
+                {
+                    field.Kind = StepKind::String;
+                    field.Size = sizeof(char);
+                    fields.push_back(field);
+                }
+                else if (type == TypeOf<std::wstring>())
+                {
+                    field.Kind = StepKind::WString;
+                    field.Size = sizeof(wchar_t);
+                    fields.push_back(field);
+                }
+                else if (const Container* container = type.GetAttribute<Container>())
+                {
+                    field.GetSize = type.GetMethod("GetSize");
+                    if (container->Kind == ContainerKind::Vector)
+                    {
+                        const Type& elementType = *type.Templates[0].Type;
+                        field.Kind = StepKind::Vector;
+                        field.Element = &GetPlanLocked(elementType);
+                        field.ElementSize = elementType.Size;
+                        field.Access = type.GetMethod("GetData");
+                        field.Insert = type.GetMethod("Resize");
+                    }
+                    else
+                    {
+                        field.Kind = StepKind::Map;
+                        field.KeyType = type.Templates[0].Type;
+                        field.Key = &GetPlanLocked(*field.KeyType);
+                        field.Element = &GetPlanLocked(*type.Templates[1].Type);
+                        field.Access = type.GetMethod("Visit");
+                        field.Insert = type.GetMethod("InsertDefaultOrGet");
+                        field.Clear = type.GetMethod("Clear");
+                    }
+                    fields.push_back(field);
+                }
+                else if (type.Kind == Kind::Class || type.Kind == Kind::Struct)
+                {
+                    // parent properties first, single inheritance: parent is at offset 0
+                    if (type.Parent != nullptr)
+                        AppendFields(fields, *type.Parent, offset, id);
+                    for (const Property& property : type.Properties)
+                    {
+                        // pointers and references are not serialized
+                        if (property.Variable.Declaration.IsValue)
+                            AppendFields(fields, *property.Variable.Declaration.Type, offset + property.Offset, HashValue(id, property.PropertyId));
+                    }
+                }
+                // unknown, forward and void types are not serialized
+            }
+
+            // element plans are built, except the one in construction (recursive type) that have a 0 hash
+            inline std::uint64_t HashLayout(const Plan& plan)
+            {
+                std::uint64_t hash = HashValue(HashSeed, plan.Type->Id);
+                hash = HashValue(hash, (std::uint64_t)plan.Type->Size);
+                hash = HashValue(hash, (std::uint64_t)plan.Type->Align);
+                for (const Step& field : plan.Fields)
+                {
+                    hash = HashValue(hash, field.Id);
+                    hash = HashValue(hash, field.FieldType->Id);
+                    hash = HashValue(hash, (std::uint64_t)field.Offset);
+                    hash = HashValue(hash, (std::uint64_t)field.Size);
+                    hash = HashValue(hash, field.Element != nullptr ? field.Element->LayoutHash : 0);
+                    hash = HashValue(hash, field.Key != nullptr ? field.Key->LayoutHash : 0);
+                }
+                return hash;
+            }
+
+            inline std::recursive_mutex& GetPlansMutex()
+            {
+                static std::recursive_mutex mutex;
+                return mutex;
+            }
+
+            // plan is inserted before its steps are built, so recursive types (ex: vector of self) reference it
+            inline const Plan& GetPlanLocked(const Type& type)
+            {
+                static std::map<const Type*, Plan> plans;
+                auto [it, inserted] = plans.try_emplace(&type);
+                Plan& plan = it->second;
+                if (inserted)
+                {
+                    std::vector<Step> fields;
+                    AppendFields(fields, type, 0, HashSeed);
+                    std::vector<Step> steps;
+                    for (const Step& field : fields)
+                    {
+                        if (field.Kind == StepKind::Copy)
+                            AppendCopy(steps, field.Offset, field.Size);
+                        else
+                            steps.push_back(field);
+                    }
+                    plan.Type = &type;
+                    plan.Fields = std::move(fields);
+                    plan.Steps = std::move(steps);
+                    plan.IsTrivial = type.HaveFlag(TypeFlags::TriviallyCopyable) && plan.Steps.size() == 1 && plan.Steps[0].Kind == StepKind::Copy && plan.Steps[0].Size == type.Size;
+                    for (const Step& step : plan.Steps)
+                        plan.MinSize += step.Kind == StepKind::Copy ? step.Size : sizeof(std::uint64_t);
+                    plan.LayoutHash = HashLayout(plan);
+                }
+                return plan;
+            }
+        }
+
+        // built once per type, thread safe
+        inline const Plan& GetPlan(const Type& type)
+        {
+            std::lock_guard<std::recursive_mutex> lock(internal::GetPlansMutex());
+            return internal::GetPlanLocked(type);
+        }
+    }
+
+#pragma endregion
+
+#pragma region Binary Migration
+
+    namespace binary
+    {
+        constexpr std::uint32_t NoSchema = ~0u;
+
+        // plan layout as written before first object of each layout (see BinaryWriter::WriteLayout)
+        struct SchemaField
+        {
+            std::uint64_t Id = 0;
+            StepKind Kind = StepKind::Copy;
+            std::uint64_t Size = 0;
+            TypeId FieldType = 0;
+            // index of element (Vector, Map value) and key (Map) plans in schema
+            std::uint32_t Element = NoSchema;
+            std::uint32_t Key = NoSchema;
+        };
+
+        struct SchemaPlan
+        {
+            std::uint64_t LayoutHash = 0;
+            std::vector<SchemaField> Fields;
+        };
+
+        struct Migration;
+
+        // written field read into Field (matched by id and declared type, or container kind), skipped if Field is nullptr
+        struct MigrationStep
+        {
+            StepKind Kind = StepKind::Copy;
+            size_t Size = 0;
+            const Step* Field = nullptr;
+            // Vector elements, Map values and keys written with another layout, nullptr if same layout (Field plans are used)
+            const Migration* Element = nullptr;
+            const Migration* Key = nullptr;
+        };
+
+        // read data written with another layout into Plan (nullptr: skip data), built once per written schema and plan
+        struct Migration
+        {
+            const Plan* Plan = nullptr;
+            std::uint64_t LayoutHash = 0;
+            std::vector<MigrationStep> Steps;
+            // Plan fields not written, copied from a default constructed object
+            std::vector<const Step*> NewFields;
+            std::shared_ptr<void> Defaults;
+            // written data size when all steps are Copy, else InvalidIndex
+            size_t SkipSize = InvalidIndex;
+            // smallest written size, bound element counts on read
+            size_t MinSize = 0;
+        };
+
+        // migrations of a single written schema, keyed on schema index and plan
+        // written layout hash is read from data, migrations are owned with their schema (not shared between readers)
+        using MigrationCache = std::map<std::pair<size_t, const Plan*>, Migration>;
+
+        // schema[index] to plan, nullptr if layouts match, built once per cache
+        const Migration* GetMigration(MigrationCache& cache, const std::vector<SchemaPlan>& schema, size_t index, const Plan* plan);
+
+        namespace internal
+        {
+            const Migration& GetMigrationLocked(MigrationCache& cache, const std::vector<SchemaPlan>& schema, size_t index, const Plan* plan);
+
+            // container fields match on kind only, elements are migrated
+            inline bool IsContainer(StepKind kind)
+            {
+                return kind == StepKind::Vector || kind == StepKind::Map;
+            }
+
+            inline const Migration* GetElementMigration(MigrationCache& cache, const std::vector<SchemaPlan>& schema, size_t index, const Plan* plan)
+            {
+                if (plan != nullptr && plan->LayoutHash == schema[index].LayoutHash)
+                    return nullptr;
+                return &GetMigrationLocked(cache, schema, index, plan);
+            }
+
+            // migration is inserted before its steps are built (recursive types)
+            inline const Migration& GetMigrationLocked(MigrationCache& cache, const std::vector<SchemaPlan>& schema, size_t index, const Plan* plan)
+            {
+                const SchemaPlan& written = schema[index];
+                auto [it, inserted] = cache.try_emplace({ index, plan });
+                Migration& migration = it->second;
+                if (!inserted)
+                    return migration;
+
+                migration.Plan = plan;
+                migration.LayoutHash = written.LayoutHash;
+                std::vector<bool> matched(plan != nullptr ? plan->Fields.size() : 0);
+                size_t skipSize = 0;
+                bool copyOnly = true;
+                for (const SchemaField& writtenField : written.Fields)
+                {
+                    MigrationStep step;
+                    step.Kind = writtenField.Kind;
+                    step.Size = (size_t)writtenField.Size;
+                    for (size_t i = 0; i < matched.size(); ++i)
+                    {
+                        const Step& field = plan->Fields[i];
+                        if (!matched[i] && field.Id == writtenField.Id && field.Kind == writtenField.Kind && (IsContainer(field.Kind) || (field.FieldType->Id == writtenField.FieldType && field.Size == writtenField.Size)))
+                        {
+                            step.Field = &field;
+                            matched[i] = true;
+                            break;
+                        }
+                    }
+                    if (writtenField.Element != NoSchema)
+                        step.Element = GetElementMigration(cache, schema, writtenField.Element, step.Field != nullptr ? step.Field->Element : nullptr);
+                    if (writtenField.Key != NoSchema)
+                        step.Key = GetElementMigration(cache, schema, writtenField.Key, step.Field != nullptr ? step.Field->Key : nullptr);
+                    if (step.Kind == StepKind::Copy)
+                        skipSize += step.Size;
+                    else
+                        copyOnly = false;
+                    migration.MinSize += step.Kind == StepKind::Copy ? step.Size : sizeof(std::uint64_t);
+                    migration.Steps.push_back(step);
+                }
+                migration.SkipSize = copyOnly ? skipSize : InvalidIndex;
+
+                for (size_t i = 0; i < matched.size(); ++i)
+                {
+                    if (!matched[i])
+                        migration.NewFields.push_back(&plan->Fields[i]);
+                }
+                if (!migration.NewFields.empty() && plan->Type->HaveNew() && plan->Type->HaveDelete())
+                    migration.Defaults = std::shared_ptr<void>(plan->Type->New(), plan->Type->Delete);
+                return migration;
+            }
+        }
+
+        inline const Migration* GetMigration(MigrationCache& cache, const std::vector<SchemaPlan>& schema, size_t index, const Plan* plan)
+        {
+            return internal::GetElementMigration(cache, schema, index, plan);
+        }
+    }
+
+#pragma endregion
+
+#pragma region Binary Writer
+
+    class BinaryWriter
+    {
+    public:
+
+        template<typename T>
+        void Write(const T& obj)
+        {
+            WriteObject(TypeOf<T>(), &obj);
+        }
+
+        void WriteObject(const Type& type, const void* obj)
+        {
+            const binary::Plan& plan = GetPlan(type);
+            WriteLayout(plan);
+            WritePlan(plan, obj);
+        }
+
+        void WriteBytes(const void* data, size_t size)
+        {
+            if (size == 0)
+                return;
+            size_t offset = buffer.size();
+            buffer.resize(offset + size);
+            std::memcpy(buffer.data() + offset, data, size);
+        }
+
+        std::span<const std::byte> GetBuffer() const { return buffer; }
+
+        void Clear()
+        {
+            buffer.clear();
+            layouts.clear();
+        }
+
+    private:
+
+        // one entry cache, same type is written many times in a row
+        const binary::Plan& GetPlan(const Type& type)
+        {
+            if (lastPlan == nullptr || lastPlan->Type != &type)
+                lastPlan = &binary::GetPlan(type);
+            return *lastPlan;
+        }
+
+        template<typename T>
+        void WriteValue(const T& value)
+        {
+            WriteBytes(&value, sizeof(value));
+        }
+
+        void WriteSize(size_t size)
+        {
+            WriteValue((std::uint64_t)size);
+        }
+
+        // layout hash and schema size, schema is written once per layout (0 size after)
+        void WriteLayout(const binary::Plan& plan)
+        {
+            WriteValue(plan.LayoutHash);
+            if (std::find(layouts.begin(), layouts.end(), plan.LayoutHash) != layouts.end())
+            {
+                WriteSize(0);
+                return;
+            }
+            layouts.push_back(plan.LayoutHash);
+            const std::vector<std::byte>& schema = GetSchema(plan);
+            WriteSize(schema.size());
+            WriteBytes(schema.data(), schema.size());
+        }
+
+        // plan and its element/key plans, root first
+        static std::vector<std::byte> BuildSchema(const binary::Plan& root)
+        {
+            std::vector<const binary::Plan*> plans = { &root };
+            auto getIndex = [&plans](const binary::Plan* plan)
+            {
+                if (plan == nullptr)
+                    return binary::NoSchema;
+                auto it = std::find(plans.begin(), plans.end(), plan);
+                if (it == plans.end())
+                {
+                    plans.push_back(plan);
+                    return (std::uint32_t)(plans.size() - 1);
+                }
+                return (std::uint32_t)(it - plans.begin());
+            };
+
+            std::vector<binary::SchemaPlan> schema;
+            for (size_t i = 0; i < plans.size(); ++i)
+            {
+                binary::SchemaPlan schemaPlan;
+                schemaPlan.LayoutHash = plans[i]->LayoutHash;
+                for (const binary::Step& field : plans[i]->Fields)
+                    schemaPlan.Fields.push_back({ field.Id, field.Kind, field.Size, field.FieldType->Id, getIndex(field.Element), getIndex(field.Key) });
+                schema.push_back(std::move(schemaPlan));
+            }
+
+            BinaryWriter writer;
+            writer.WriteValue((std::uint32_t)schema.size());
+            for (const binary::SchemaPlan& schemaPlan : schema)
+            {
+                writer.WriteValue(schemaPlan.LayoutHash);
+                writer.WriteValue((std::uint32_t)schemaPlan.Fields.size());
+                for (const binary::SchemaField& field : schemaPlan.Fields)
+                {
+                    writer.WriteValue(field.Id);
+                    writer.WriteValue(field.Kind);
+                    writer.WriteValue(field.Size);
+                    writer.WriteValue(field.FieldType);
+                    writer.WriteValue(field.Element);
+                    writer.WriteValue(field.Key);
+                }
+            }
+            return std::move(writer.buffer);
+        }
+
+        // built once per plan
+        static const std::vector<std::byte>& GetSchema(const binary::Plan& plan)
+        {
+            std::lock_guard<std::recursive_mutex> lock(binary::internal::GetPlansMutex());
+            static std::map<const binary::Plan*, std::vector<std::byte>> schemas;
+            auto [it, inserted] = schemas.try_emplace(&plan);
+            if (inserted)
+                it->second = BuildSchema(plan);
+            return it->second;
+        }
+
+        void WritePlan(const binary::Plan& plan, const void* obj)
+        {
+            const std::byte* bytes = static_cast<const std::byte*>(obj);
+            for (const binary::Step& step : plan.Steps)
+            {
+                const std::byte* member = bytes + step.Offset;
+                switch (step.Kind)
+                {
+                    case binary::StepKind::Copy:
+                        WriteBytes(member, step.Size);
+                        break;
+                    case binary::StepKind::String:
+                        WriteString(*reinterpret_cast<const std::string*>(member));
+                        break;
+                    case binary::StepKind::WString:
+                        WriteString(*reinterpret_cast<const std::wstring*>(member));
+                        break;
+                    case binary::StepKind::Vector:
+                        WriteVector(step, const_cast<std::byte*>(member));
+                        break;
+                    case binary::StepKind::Map:
+                        WriteMap(step, const_cast<std::byte*>(member));
+                        break;
+                }
+            }
+        }
+
+        template<typename STRING>
+        void WriteString(const STRING& str)
+        {
+            WriteSize(str.size());
+            WriteBytes(str.data(), str.size() * sizeof(typename STRING::value_type));
+        }
+
+        void WriteVector(const binary::Step& step, void* vector)
+        {
+            size_t size = 0;
+            std::byte* data = nullptr;
+            step.GetSize->UnSafeCall(vector, &size, {});
+            step.Access->UnSafeCall(vector, &data, {});
+
+            WriteSize(size);
+            if (step.Element->IsTrivial)
+            {
+                WriteBytes(data, size * step.ElementSize);
+            }
+            else
+            {
+                for (size_t i = 0; i < size; ++i)
+                    WritePlan(*step.Element, data + i * step.ElementSize);
+            }
+        }
+
+        struct MapVisitContext
+        {
+            BinaryWriter* Writer;
+            const binary::Step* Step;
+        };
+
+        void WriteMap(const binary::Step& step, void* map)
+        {
+            size_t size = 0;
+            step.GetSize->UnSafeCall(map, &size, {});
+            WriteSize(size);
+
+            MapVisitContext context = { this, &step };
+            utils::MapVisitFunction visit = [](void* context, const void* key, void* value)
+            {
+                MapVisitContext& visitContext = *static_cast<MapVisitContext*>(context);
+                visitContext.Writer->WritePlan(*visitContext.Step->Key, key);
+                visitContext.Writer->WritePlan(*visitContext.Step->Element, value);
+            };
+            void* contextPtr = &context;
+            void* visitArgs[] = { &visit, &contextPtr };
+            step.Access->UnSafeCall(map, NoReturn, visitArgs);
+        }
+
+        std::vector<std::byte> buffer;
+        // layouts having their schema written
+        std::vector<std::uint64_t> layouts;
+        const binary::Plan* lastPlan = nullptr;
+    };
+
+#pragma endregion
+
+#pragma region Binary Reader
+
+    // read data written by BinaryWriter, Read* return false if data is truncated or have an unknown layout
+    class BinaryReader
+    {
+    public:
+
+        BinaryReader(std::span<const std::byte> data)
+            : data(data) {}
+
+        template<typename T>
+        bool Read(T& obj)
+        {
+            return ReadObject(TypeOf<T>(), &obj);
+        }
+
+        bool ReadObject(const Type& type, void* obj)
+        {
+            const binary::Plan& plan = GetPlan(type);
+            const binary::Migration* migration = nullptr;
+            if (!ReadLayout(plan, migration))
+                return false;
+            // same layout: plan only, no migration cost
+            if (migration == nullptr)
+                return ReadPlan(plan, obj);
+            return ReadMigration(*migration, obj, true);
+        }
+
+        bool ReadBytes(void* dst, size_t size)
+        {
+            if (size > data.size() - offset)
+                return false;
+            if (size != 0)
+                std::memcpy(dst, data.data() + offset, size);
+            offset += size;
+            return true;
+        }
+
+        bool Skip(size_t size)
+        {
+            if (size > data.size() - offset)
+                return false;
+            offset += size;
+            return true;
+        }
+
+        size_t GetOffset() const { return offset; }
+        bool IsEnd() const { return offset == data.size(); }
+
+    private:
+
+        const binary::Plan& GetPlan(const Type& type)
+        {
+            if (lastPlan == nullptr || lastPlan->Type != &type)
+                lastPlan = &binary::GetPlan(type);
+            return *lastPlan;
+        }
+
+        // size is validated against remaining data (each element is at least one byte, or elementSize bytes)
+        bool ReadSize(size_t& size, size_t minElementSize)
+        {
+            std::uint64_t value = 0;
+            if (!ReadBytes(&value, sizeof(value)))
+                return false;
+            if (minElementSize != 0 && value > (data.size() - offset) / minElementSize)
+                return false;
+            size = (size_t)value;
+            return true;
+        }
+
+        struct Layout
+        {
+            std::uint64_t LayoutHash = 0;
+            std::vector<binary::SchemaPlan> Schema;
+            binary::MigrationCache Migrations;
+            const binary::Migration* Migration = nullptr;
+        };
+
+        // see BinaryWriter::WriteLayout, migration is nullptr if layout match plan
+        // same layout skip schema without keeping state, other layouts keep their schema for next objects
+        bool ReadLayout(const binary::Plan& plan, const binary::Migration*& migration)
+        {
+            std::uint64_t layoutHash = 0;
+            size_t schemaSize = 0;
+            if (!ReadBytes(&layoutHash, sizeof(layoutHash)) || !ReadSize(schemaSize, 1))
+                return false;
+            if (layoutHash == plan.LayoutHash)
+                return Skip(schemaSize);
+
+            if (schemaSize == 0)
+            {
+                for (Layout& layout : layouts)
+                {
+                    if (layout.LayoutHash != layoutHash)
+                        continue;
+                    if (layout.Migration == nullptr || layout.Migration->Plan != &plan)
+                        layout.Migration = binary::GetMigration(layout.Migrations, layout.Schema, 0, &plan);
+                    migration = layout.Migration;
+                    return true;
+                }
+                // schema was skipped (read with matching plan) or is missing
+                return false;
+            }
+
+            Layout layout;
+            layout.LayoutHash = layoutHash;
+            BinaryReader schemaReader(data.subspan(offset, schemaSize));
+            if (!schemaReader.ReadSchema(layout.Schema) || !schemaReader.IsEnd() || layout.Schema[0].LayoutHash != layoutHash)
+                return false;
+            offset += schemaSize;
+            layout.Migration = binary::GetMigration(layout.Migrations, layout.Schema, 0, &plan);
+            migration = layout.Migration;
+            layouts.push_back(std::move(layout));
+            return true;
+        }
+
+        bool ReadSchema(std::vector<binary::SchemaPlan>& schema)
+        {
+            std::uint32_t planCount = 0;
+            if (!ReadBytes(&planCount, sizeof(planCount)) || planCount == 0 || planCount > data.size() - offset)
+                return false;
+            schema.resize(planCount);
+            for (binary::SchemaPlan& schemaPlan : schema)
+            {
+                std::uint32_t fieldCount = 0;
+                if (!ReadBytes(&schemaPlan.LayoutHash, sizeof(schemaPlan.LayoutHash)) || !ReadBytes(&fieldCount, sizeof(fieldCount)) || fieldCount > data.size() - offset)
+                    return false;
+                schemaPlan.Fields.resize(fieldCount);
+                for (binary::SchemaField& field : schemaPlan.Fields)
+                {
+                    bool read = ReadBytes(&field.Id, sizeof(field.Id)) && ReadBytes(&field.Kind, sizeof(field.Kind)) && ReadBytes(&field.Size, sizeof(field.Size)) &&
+                        ReadBytes(&field.FieldType, sizeof(field.FieldType)) && ReadBytes(&field.Element, sizeof(field.Element)) && ReadBytes(&field.Key, sizeof(field.Key));
+                    if (!read || field.Kind > binary::StepKind::Map)
+                        return false;
+                    bool needElement = field.Kind == binary::StepKind::Vector || field.Kind == binary::StepKind::Map;
+                    bool needKey = field.Kind == binary::StepKind::Map;
+                    if ((field.Element != binary::NoSchema) != needElement || (field.Key != binary::NoSchema) != needKey)
+                        return false;
+                    if ((needElement && field.Element >= planCount) || (needKey && field.Key >= planCount))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        // obj is nullptr to skip data, new fields get default value only on root object (elements are default constructed)
+        bool ReadMigration(const binary::Migration& migration, void* obj, bool defaults)
+        {
+            if (obj == nullptr && migration.SkipSize != InvalidIndex)
+                return Skip(migration.SkipSize);
+
+            std::byte* bytes = static_cast<std::byte*>(obj);
+            for (const binary::MigrationStep& step : migration.Steps)
+            {
+                std::byte* member = bytes != nullptr && step.Field != nullptr ? bytes + step.Field->Offset : nullptr;
+                bool read = false;
+                switch (step.Kind)
+                {
+                    case binary::StepKind::Copy:
+                        read = member != nullptr ? ReadBytes(member, step.Size) : Skip(step.Size);
+                        break;
+                    case binary::StepKind::String:
+                        read = member != nullptr ? ReadString(*reinterpret_cast<std::string*>(member)) : SkipString(step.Size);
+                        break;
+                    case binary::StepKind::WString:
+                        read = member != nullptr ? ReadString(*reinterpret_cast<std::wstring*>(member)) : SkipString(step.Size);
+                        break;
+                    case binary::StepKind::Vector:
+                        read = ReadMigratedVector(step, member);
+                        break;
+                    case binary::StepKind::Map:
+                        read = ReadMigratedMap(step, member);
+                        break;
+                }
+                if (!read)
+                    return false;
+            }
+
+            if (bytes != nullptr && defaults && migration.Defaults != nullptr)
+            {
+                const std::byte* defaultBytes = static_cast<const std::byte*>(migration.Defaults.get());
+                for (const binary::Step* field : migration.NewFields)
+                {
+                    const Type& fieldType = *field->FieldType;
+                    if (field->Kind == binary::StepKind::Copy)
+                    {
+                        std::memcpy(bytes + field->Offset, defaultBytes + field->Offset, field->Size);
+                    }
+                    else if (fieldType.HaveDestroy() && fieldType.HaveCopyConstruct())
+                    {
+                        fieldType.Destruct(bytes + field->Offset);
+                        fieldType.CopyConstruct(const_cast<std::byte*>(defaultBytes + field->Offset), bytes + field->Offset);
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool SkipString(size_t charSize)
+        {
+            size_t size = 0;
+            return ReadSize(size, charSize) && Skip(size * charSize);
+        }
+
+        // element written with another layout (migration) or same layout (plan)
+        bool ReadElement(const binary::Migration* migration, const binary::Plan& plan, void* obj)
+        {
+            return migration != nullptr ? ReadMigration(*migration, obj, false) : ReadPlan(plan, obj);
+        }
+
+        bool ReadMigratedVector(const binary::MigrationStep& step, void* vector)
+        {
+            // corrupted count fail before resize (elements without written data count one byte)
+            size_t size = 0;
+            if (vector == nullptr)
+            {
+                size_t skipSize = step.Element->SkipSize;
+                if (!ReadSize(size, std::max<size_t>(step.Element->MinSize, 1)))
+                    return false;
+                if (skipSize != InvalidIndex)
+                    return Skip(size * skipSize);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (!ReadMigration(*step.Element, nullptr, false))
+                        return false;
+                }
+                return true;
+            }
+
+            if (step.Element == nullptr)
+                return ReadVector(*step.Field, vector);
+
+            const binary::Step& field = *step.Field;
+            if (!ReadSize(size, std::max<size_t>(step.Element->MinSize, 1)))
+                return false;
+            // cleared first, fields not written keep default value
+            size_t empty = 0;
+            void* clearArgs[] = { &empty };
+            field.Insert->UnSafeCall(vector, NoReturn, clearArgs);
+            void* resizeArgs[] = { &size };
+            field.Insert->UnSafeCall(vector, NoReturn, resizeArgs);
+            std::byte* elements = nullptr;
+            field.Access->UnSafeCall(vector, &elements, {});
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (!ReadMigration(*step.Element, elements + i * field.ElementSize, false))
+                    return false;
+            }
+            return true;
+        }
+
+        bool ReadMigratedMap(const binary::MigrationStep& step, void* map)
+        {
+            // key and value written with same layout (nullptr migration) are read with field plans
+            size_t keySize = step.Key != nullptr ? step.Key->MinSize : step.Field->Key->MinSize;
+            size_t valueSize = step.Element != nullptr ? step.Element->MinSize : step.Field->Element->MinSize;
+            size_t size = 0;
+            if (!ReadSize(size, std::max<size_t>(keySize + valueSize, 1)))
+                return false;
+
+            if (map == nullptr)
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (!ReadMigration(*step.Key, nullptr, false) || !ReadMigration(*step.Element, nullptr, false))
+                        return false;
+                }
+                return true;
+            }
+
+            const binary::Step& field = *step.Field;
+            field.Clear->UnSafeCall(map, NoReturn, {});
+            if (size == 0)
+                return true;
+
+            void* key = field.KeyType->New();
+            bool read = true;
+            for (size_t i = 0; i < size && read; ++i)
+            {
+                void* value = nullptr;
+                read = ReadElement(step.Key, *field.Key, key) && InsertKey(field, map, key, i, value) && ReadElement(step.Element, *field.Element, value);
+            }
+            field.KeyType->Delete(key);
+            return read;
+        }
+
+        bool ReadPlan(const binary::Plan& plan, void* obj)
+        {
+            std::byte* bytes = static_cast<std::byte*>(obj);
+            for (const binary::Step& step : plan.Steps)
+            {
+                std::byte* member = bytes + step.Offset;
+                bool read = false;
+                switch (step.Kind)
+                {
+                    case binary::StepKind::Copy:
+                        read = ReadBytes(member, step.Size);
+                        break;
+                    case binary::StepKind::String:
+                        read = ReadString(*reinterpret_cast<std::string*>(member));
+                        break;
+                    case binary::StepKind::WString:
+                        read = ReadString(*reinterpret_cast<std::wstring*>(member));
+                        break;
+                    case binary::StepKind::Vector:
+                        read = ReadVector(step, member);
+                        break;
+                    case binary::StepKind::Map:
+                        read = ReadMap(step, member);
+                        break;
+                }
+                if (!read)
+                    return false;
+            }
+            return true;
+        }
+
+        template<typename STRING>
+        bool ReadString(STRING& str)
+        {
+            using Char = typename STRING::value_type;
+            size_t size = 0;
+            if (!ReadSize(size, sizeof(Char)))
+                return false;
+            str.resize(size);
+            return ReadBytes(str.data(), size * sizeof(Char));
+        }
+
+        bool ReadVector(const binary::Step& step, void* vector)
+        {
+            // corrupted count fail before resize (elements without written data count one byte)
+            size_t size = 0;
+            if (!ReadSize(size, std::max<size_t>(step.Element->MinSize, 1)))
+                return false;
+
+            void* resizeArgs[] = { &size };
+            step.Insert->UnSafeCall(vector, NoReturn, resizeArgs);
+            std::byte* data = nullptr;
+            step.Access->UnSafeCall(vector, &data, {});
+
+            if (step.Element->IsTrivial)
+                return ReadBytes(data, size * step.ElementSize);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (!ReadPlan(*step.Element, data + i * step.ElementSize))
+                    return false;
+            }
+            return true;
+        }
+
+        // insert key in map holding index keys, repeated key is corrupted data
+        bool InsertKey(const binary::Step& step, void* map, void* key, size_t index, void*& value)
+        {
+            void* insertArgs[] = { &key };
+            step.Insert->UnSafeCall(map, &value, insertArgs);
+            size_t size = 0;
+            step.GetSize->UnSafeCall(map, &size, {});
+            return size == index + 1;
+        }
+
+        bool ReadMap(const binary::Step& step, void* map)
+        {
+            size_t size = 0;
+            if (!ReadSize(size, std::max<size_t>(step.Key->MinSize + step.Element->MinSize, 1)))
+                return false;
+
+            step.Clear->UnSafeCall(map, NoReturn, {});
+            if (size == 0)
+                return true;
+
+            // key is read in a single temporary, then inserted
+            void* key = step.KeyType->New();
+            bool read = true;
+            for (size_t i = 0; i < size && read; ++i)
+            {
+                void* value = nullptr;
+                read = ReadPlan(*step.Key, key) && InsertKey(step, map, key, i, value) && ReadPlan(*step.Element, value);
+            }
+            step.KeyType->Delete(key);
+            return read;
+        }
+
+        std::span<const std::byte> data;
+        size_t offset = 0;
+        std::vector<Layout> layouts;
+        const binary::Plan* lastPlan = nullptr;
+    };
+
+#pragma endregion
+
+}
@@ -0,0 +1,1461 @@
+//  MIT License
+//
+//  Copyright (c) 2024 Eric Thiffeault
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// https://github.com/ethiffeault/eti
+
+#pragma once
+
+// json serialization of reflected types
+//
+//  JsonWriter: single pass, append into a growable buffer (optionally flushed to a WriteFunction)
+//  JsonReader: pull parser (Next() return tokens) over a string or chunked input (ReadFunction), no dom
+//
+//  each Type get a json plan (once): fields (inherited then own properties) with their pre-rendered
+//  "name": key and a PropertyId table used to match keys while reading (no string compare).
+//  enum are written by name (flags: "A|B"), std::vector as array, std::map as object (string, integer
+//  or enum keys), pointers are not serialized.
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <eti/eti.h>
+
+#ifndef ETI_JSON_SIMD
+    // instruction set of json block scanner: 0 scalar, 1 SSE2, 2 AVX2
+    // default to best enabled by compiler flags (ex: -mavx2, /arch:AVX2)
+    #if defined(__AVX2__)
+        #define ETI_JSON_SIMD 2
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define ETI_JSON_SIMD 1
+    #else
+        #define ETI_JSON_SIMD 0
+    #endif
+#endif
+
+#if ETI_JSON_SIMD
+    #include <immintrin.h>
+#endif
+
+namespace eti
+{
+
+#pragma region Json Scanner
+
+    namespace json::internal
+    {
+        static constexpr size_t ScanBlockSize = 64;
+
+        // classification of a 64 bytes block, bit i is set if byte i match
+        struct BlockMasks
+        {
+            std::uint64_t Quote = 0;        // '"'
+            std::uint64_t Backslash = 0;    // '\\'
+            std::uint64_t Operator = 0;     // '{', '}', '[', ']', ':', ','
+            std::uint64_t Space = 0;        // ' ', '\t', '\n', '\r'
+        };
+
+#if ETI_JSON_SIMD == 2
+
+        inline void ScanLane(const char* ptr, BlockMasks& masks, int shift)
+        {
+            __m256i c = _mm256_loadu_si256((const __m256i*)ptr);
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+            __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+            __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8(','))));
+            __m256i space = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\t'))));
+            masks.Quote |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('"'))) << shift;
+            masks.Backslash |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\\'))) << shift;
+            masks.Operator |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(op) << shift;
+            masks.Space |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(space) << shift;
+        }
+
+        inline BlockMasks ScanBlock(const char* ptr)
+        {
+            BlockMasks masks;
+            ScanLane(ptr, masks, 0);
+            ScanLane(ptr + 32, masks, 32);
+            return masks;
+        }
+
+        // first '\\' or control character in [first, last)
+        inline const char* FindEscape(const char* first, const char* last)
+        {
+            for (; last - first >= 32; first += 32)
+            {
+                __m256i c = _mm256_loadu_si256((const __m256i*)first);
+                __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(c, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+                if (std::uint32_t mask = (std::uint32_t)_mm256_movemask_epi8(_mm256_or_si256(control, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\\')))))
+                    return first + std::countr_zero(mask);
+            }
+            while (first != last && *first != '\\' && (unsigned char)*first >= 0x20)
+                ++first;
+            return first;
+        }
+
+#elif ETI_JSON_SIMD == 1
+
+        inline void ScanLane(const char* ptr, BlockMasks& masks, int shift)
+        {
+            __m128i c = _mm_loadu_si128((const __m128i*)ptr);
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+            __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+            __m128i op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(':')), _mm_cmpeq_epi8(c, _mm_set1_epi8(','))));
+            __m128i space = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\n'))),
+                _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\t'))));
+            masks.Quote |= (std::uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8('"'))) << shift;
+            masks.Backslash |= (std::uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8('\\'))) << shift;
+            masks.Operator |= (std::uint64_t)_mm_movemask_epi8(op) << shift;
+            masks.Space |= (std::uint64_t)_mm_movemask_epi8(space) << shift;
+        }
+
+        inline BlockMasks ScanBlock(const char* ptr)
+        {
+            BlockMasks masks;
+            ScanLane(ptr, masks, 0);
+            ScanLane(ptr + 16, masks, 16);
+            ScanLane(ptr + 32, masks, 32);
+            ScanLane(ptr + 48, masks, 48);
+            return masks;
+        }
+
+        // first '\\' or control character in [first, last)
+        inline const char* FindEscape(const char* first, const char* last)
+        {
+            for (; last - first >= 16; first += 16)
+            {
+                __m128i c = _mm_loadu_si128((const __m128i*)first);
+                __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(c, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+                if (std::uint32_t mask = (std::uint32_t)_mm_movemask_epi8(_mm_or_si128(control, _mm_cmpeq_epi8(c, _mm_set1_epi8('\\')))))
+                    return first + std::countr_zero(mask);
+            }
+            while (first != last && *first != '\\' && (unsigned char)*first >= 0x20)
+                ++first;
+            return first;
+        }
+
+#else
+
+        inline BlockMasks ScanBlock(const char* ptr)
+        {
+            BlockMasks masks;
+            for (size_t i = 0; i < ScanBlockSize; ++i)
+            {
+                std::uint64_t bit = (std::uint64_t)1 << i;
+                switch (ptr[i])
+                {
+                    case '"': masks.Quote |= bit; break;
+                    case '\\': masks.Backslash |= bit; break;
+                    case '{': case '}': case '[': case ']': case ':': case ',': masks.Operator |= bit; break;
+                    case ' ': case '\t': case '\n': case '\r': masks.Space |= bit; break;
+                    default: break;
+                }
+            }
+            return masks;
+        }
+
+        // first '\\' or control character in [first, last)
+        inline const char* FindEscape(const char* first, const char* last)
+        {
+            while (first != last && *first != '\\' && (unsigned char)*first >= 0x20)
+                ++first;
+            return first;
+        }
+
+#endif
+
+        // bit i = xor of bits [0, i]
+        constexpr std::uint64_t PrefixXor(std::uint64_t bits)
+        {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        // find structural characters 64 bytes at a time: operators and quotes outside of strings, and the first
+        // character of each number/literal. state is carried between blocks (string, escape and scalar), so
+        // input can be scanned by chunks.
+        class StructuralScanner
+        {
+        public:
+
+            // append offset + index of block structurals in positions, return count
+            size_t Scan(const char* block, size_t offset, size_t* positions)
+            {
+                size_t count = 0;
+                for (std::uint64_t structurals = ScanStructurals(block); structurals != 0; structurals &= structurals - 1)
+                    positions[count++] = offset + std::countr_zero(structurals);
+                return count;
+            }
+
+            // bit i is set if block[i] is structural
+            std::uint64_t ScanStructurals(const char* block)
+            {
+                BlockMasks masks = ScanBlock(block);
+
+                // escaped characters, a backslash escape next one (backslashes are rare, so bit loop)
+                std::uint64_t escaped = 0;
+                if (masks.Backslash != 0 || escapeCarry)
+                {
+                    std::uint64_t backslash = masks.Backslash;
+                    if (escapeCarry)
+                    {
+                        escaped = 1;
+                        backslash &= ~(std::uint64_t)1;
+                    }
+                    escapeCarry = false;
+                    while (backslash != 0)
+                    {
+                        int index = std::countr_zero(backslash);
+                        if (index == 63)
+                        {
+                            escapeCarry = true;
+                            break;
+                        }
+                        escaped |= (std::uint64_t)1 << (index + 1);
+                        backslash &= ~((std::uint64_t)3 << index);
+                    }
+                }
+
+                // string mask from opening quote (included) to closing quote (excluded)
+                std::uint64_t quote = masks.Quote & ~escaped;
+                std::uint64_t inString = PrefixXor(quote) ^ stringCarry;
+                stringCarry = (std::uint64_t)((std::int64_t)inString >> 63);
+
+                std::uint64_t scalar = ~(masks.Operator | masks.Space | quote | inString);
+                std::uint64_t scalarStart = scalar & ~((scalar << 1) | scalarCarry);
+                scalarCarry = scalar >> 63;
+                return (masks.Operator & ~inString) | quote | scalarStart;
+            }
+
+        private:
+            std::uint64_t stringCarry = 0;
+            std::uint64_t scalarCarry = 0;
+            bool escapeCarry = false;
+        };
+    }
+
+#pragma endregion
+
+#pragma region Json Plan
+
+    namespace json
+    {
+        enum class ValueKind : std::uint8_t
+        {
+            None,       // not serialized
+            Bool,
+            S8,
+            S16,
+            S32,
+            S64,
+            U8,
+            U16,
+            U32,
+            U64,
+            F32,
+            F64,
+            Enum,
+            String,
+            Object,     // struct/class properties
+            Vector,     // reflected std::vector
+            Map         // reflected std::map
+        };
+
+        struct Plan;
+
+        struct Field
+        {
+            std::string_view Name;
+            TypeId PropertyId = 0;
+            // "name": escaped, ready to append
+            std::string Key;
+            size_t Offset = 0;
+            const Plan* Value = nullptr;
+        };
+
+        struct Plan
+        {
+            const Type* Type = nullptr;
+            ValueKind Kind = ValueKind::None;
+
+            // Object: inherited then own fields, table keyed by PropertyId
+            std::vector<Field> Fields;
+            std::span<const eti::internal::MemberSlot<Field>> FieldTable;
+
+            // Vector: element, Map: key and value
+            const Plan* Key = nullptr;
+            const Plan* Element = nullptr;
+            size_t ElementSize = 0;
+
+            // Enum: underlying type is signed (entries values are sign extended)
+            bool EnumSigned = false;
+
+            // container methods, Vector: GetSize, GetData, AddDefault, Clear, Map: GetSize, Visit, InsertDefaultOrGet, Clear
+            const Method* GetSize = nullptr;
+            const Method* Access = nullptr;
+            const Method* Insert = nullptr;
+            const Method* Clear = nullptr;
+        };
+
+        inline TypeId GetMemberId(const Field& field) { return field.PropertyId; }
+        inline std::string_view GetMemberName(const Field& field) { return field.Name; }
+
+        const Plan& GetPlan(const Type& type);
+
+        namespace internal
+        {
+            inline void AppendEscaped(std::string& buffer, std::string_view str)
+            {
+                static constexpr char hex[] = "0123456789abcdef";
+                size_t start = 0;
+                for (size_t i = 0; i < str.size(); ++i)
+                {
+                    unsigned char c = (unsigned char)str[i];
+                    if (c != '"' && c != '\\' && c >= 0x20)
+                        continue;
+
+                    buffer.append(str.data() + start, i - start);
+                    start = i + 1;
+                    switch (c)
+                    {
+                        case '"': buffer.append("\\\""); break;
+                        case '\\': buffer.append("\\\\"); break;
+                        case '\n': buffer.append("\\n"); break;
+                        case '\r': buffer.append("\\r"); break;
+                        case '\t': buffer.append("\\t"); break;
+                        case '\b': buffer.append("\\b"); break;
+                        case '\f': buffer.append("\\f"); break;
+                        default:
+                        {
+                            char escape[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+                            buffer.append(escape, sizeof(escape));
+                        }
+                    }
+                }
+                buffer.append(str.data() + start, str.size() - start);
+            }
+
+            inline ValueKind GetPodKind(const Type& type)
+            {
+                if (type == TypeOf<bool>()) return ValueKind::Bool;
+                if (type == TypeOf<std::int8_t>()) return ValueKind::S8;
+                if (type == TypeOf<std::int16_t>()) return ValueKind::S16;
+                if (type == TypeOf<std::int32_t>()) return ValueKind::S32;
+                if (type == TypeOf<std::int64_t>()) return ValueKind::S64;
+                if (type == TypeOf<std::uint8_t>()) return ValueKind::U8;
+                if (type == TypeOf<std::uint16_t>()) return ValueKind::U16;
+                if (type == TypeOf<std::uint32_t>()) return ValueKind::U32;
+                if (type == TypeOf<std::uint64_t>()) return ValueKind::U64;
+                if (type == TypeOf<float>()) return ValueKind::F32;
+                if (type == TypeOf<double>()) return ValueKind::F64;
+                return ValueKind::None;
+            }
+
+            inline bool IsKeyKind(ValueKind kind)
+            {
+                return kind == ValueKind::String || kind == ValueKind::Enum || (kind >= ValueKind::S8 && kind <= ValueKind::U64);
+            }
+
+            const Plan& GetPlanLocked(const Type& type);
+
+            inline void BuildPlan(Plan& plan, const Type& type)
+            {
+                plan.Type = &type;
+                if (type.Kind == Kind::Pod)
+                {
+                    plan.Kind = GetPodKind(type);
+                }
+                else if (type.Kind == Kind::Enum)
+                {
+                    plan.Kind = ValueKind::Enum;
+                    // negative values of signed underlying type are sign extended above type size
+                    size_t mask = type.Size >= sizeof(size_t) ? ~(size_t)0 : ((size_t)1 << (type.Size * 8)) - 1;
+                    plan.EnumSigned = std::ranges::any_of(type.EnumEntries, [mask](const EnumEntry& entry) { return entry.Value > mask; });
+                }
+                else if (type == TypeOf<std::string>())
+                {
+                    plan.Kind = ValueKind::String;
+                }
+                else if (const Container* container = type.GetAttribute<Container>())
+                {
+                    plan.GetSize = type.GetMethod("GetSize");
+                    plan.Clear = type.GetMethod("Clear");
+                    if (container->Kind == ContainerKind::Vector)
+                    {
+                        plan.Kind = ValueKind::Vector;
+                        plan.Element = &GetPlanLocked(*type.Templates[0].Type);
+                        plan.ElementSize = type.Templates[0].Type->Size;
+                        plan.Access = type.GetMethod("GetData");
+                        plan.Insert = type.GetMethod("AddDefault");
+                    }
+                    else
+                    {
+                        const Plan& key = GetPlanLocked(*type.Templates[0].Type);
+                        // json object keys are strings, other keys are not serialized
+                        if (IsKeyKind(key.Kind))
+                        {
+                            plan.Kind = ValueKind::Map;
+                            plan.Key = &key;
+                            plan.Element = &GetPlanLocked(*type.Templates[1].Type);
+                            plan.Access = type.GetMethod("Visit");
+                            // repeated key is valid json, last one wins
+                            plan.Insert = type.GetMethod("InsertDefaultOrGet");
+                        }
+                    }
+                }
+                else if (type.Kind == Kind::Class || type.Kind == Kind::Struct)
+                {
+                    plan.Kind = ValueKind::Object;
+                    if (type.Parent != nullptr)
+                        plan.Fields = GetPlanLocked(*type.Parent).Fields;
+
+                    for (const Property& property : type.Properties)
+                    {
+                        if (!property.Variable.Declaration.IsValue)
+                            continue;
+                        const Plan& value = GetPlanLocked(*property.Variable.Declaration.Type);
+                        if (value.Kind == ValueKind::None)
+                            continue;
+
+                        Field field = { property.Variable.Name, property.PropertyId, "\"", property.Offset, &value };
+                        AppendEscaped(field.Key, field.Name);
+                        field.Key.append("\":");
+
+                        // own property hide inherited one with same name
+                        auto it = std::ranges::find_if(plan.Fields, [&field](const Field& f) { return f.PropertyId == field.PropertyId && f.Name == field.Name; });
+                        if (it != plan.Fields.end())
+                            *it = std::move(field);
+                        else
+                            plan.Fields.push_back(std::move(field));
+                    }
+                    plan.FieldTable = eti::internal::MakeMemberTable(std::span<const Field>(plan.Fields), {});
+                }
+            }
+
+            inline std::recursive_mutex& GetPlansMutex()
+            {
+                static std::recursive_mutex mutex;
+                return mutex;
+            }
+
+            // plan is inserted before built, so recursive types (ex: vector of self) reference it
+            inline const Plan& GetPlanLocked(const Type& type)
+            {
+                static std::map<const Type*, Plan> plans;
+                auto [it, inserted] = plans.try_emplace(&type);
+                if (inserted)
+                    BuildPlan(it->second, type);
+                return it->second;
+            }
+
+            // enum value as stored in EnumEntries (sign extended if underlying type is signed)
+            inline size_t LoadEnum(const Plan& plan, const void* ptr)
+            {
+                switch (plan.Type->Size)
+                {
+                    case 1: return plan.EnumSigned ? (size_t)*(const std::int8_t*)ptr : (size_t)*(const std::uint8_t*)ptr;
+                    case 2: return plan.EnumSigned ? (size_t)*(const std::int16_t*)ptr : (size_t)*(const std::uint16_t*)ptr;
+                    case 4: return plan.EnumSigned ? (size_t)*(const std::int32_t*)ptr : (size_t)*(const std::uint32_t*)ptr;
+                    default: return (size_t)*(const std::uint64_t*)ptr;
+                }
+            }
+
+            inline void StoreEnum(const Plan& plan, void* ptr, size_t value)
+            {
+                switch (plan.Type->Size)
+                {
+                    case 1: *(std::uint8_t*)ptr = (std::uint8_t)value; break;
+                    case 2: *(std::uint16_t*)ptr = (std::uint16_t)value; break;
+                    case 4: *(std::uint32_t*)ptr = (std::uint32_t)value; break;
+                    default: *(std::uint64_t*)ptr = (std::uint64_t)value; break;
+                }
+            }
+
+            // generic conversion, fallback of fast paths below
+            template<typename T>
+            bool ParseChars(std::string_view text, void* ptr)
+            {
+                T value;
+                auto [last, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+                if (error != std::errc() || last != text.data() + text.size())
+                    return false;
+                *(T*)ptr = value;
+                return true;
+            }
+
+            // up to 19 digits accumulate in uint64 without overflow
+            template<typename T>
+            bool ParseInteger(std::string_view text, void* ptr)
+            {
+                const char* first = text.data();
+                const char* last = first + text.size();
+                bool negative = std::is_signed_v<T> && first != last && *first == '-';
+                first += negative;
+                if (first == last || last - first > 19)
+                    return ParseChars<T>(text, ptr);
+
+                std::uint64_t value = 0;
+                for (; first != last; ++first)
+                {
+                    unsigned digit = (unsigned)(*first - '0');
+                    if (digit > 9)
+                        return false;
+                    value = value * 10 + digit;
+                }
+
+                std::uint64_t max = (std::uint64_t)std::numeric_limits<T>::max() + negative;
+                if (value > max)
+                    return false;
+                *(T*)ptr = negative ? (T)(0 - value) : (T)value;
+                return true;
+            }
+
+            // exact when mantissa and power of 10 are exactly representable (one rounding), else ParseChars
+            template<typename T>
+            bool ParseFloat(std::string_view text, void* ptr)
+            {
+                static constexpr double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+                static constexpr int maxPower = std::is_same_v<T, float> ? 10 : 22;
+                static constexpr std::uint64_t maxMantissa = (std::uint64_t)1 << std::numeric_limits<T>::digits;
+
+                const char* first = text.data();
+                const char* last = first + text.size();
+                bool negative = first != last && *first == '-';
+                first += negative;
+
+                std::uint64_t mantissa = 0;
+                int digits = 0;
+                int exponent = 0;
+                const char* integer = first;
+                for (; first != last && (unsigned)(*first - '0') <= 9; ++first, ++digits)
+                    mantissa = mantissa * 10 + (unsigned)(*first - '0');
+                if (first == integer)
+                    return false;
+                if (first != last && *first == '.')
+                {
+                    const char* fraction = ++first;
+                    for (; first != last && (unsigned)(*first - '0') <= 9; ++first, ++digits)
+                        mantissa = mantissa * 10 + (unsigned)(*first - '0');
+                    if (first == fraction)
+                        return false;
+                    exponent = -(int)(first - fraction);
+                }
+                if (first != last && (*first == 'e' || *first == 'E'))
+                {
+                    ++first;
+                    bool negativeExponent = first != last && *first == '-';
+                    first += first != last && (*first == '-' || *first == '+');
+                    int value = 0;
+                    const char* start = first;
+                    for (; first != last && (unsigned)(*first - '0') <= 9 && value < 10000; ++first)
+                        value = value * 10 + (*first - '0');
+                    if (first == start)
+                        return false;
+                    exponent += negativeExponent ? -value : value;
+                }
+                if (first != last)
+                    return ParseChars<T>(text, ptr);
+
+                if (digits > 19 || mantissa > maxMantissa || exponent < -maxPower || exponent > maxPower)
+                    return ParseChars<T>(text, ptr);
+
+                T value = (T)mantissa;
+                if (exponent < 0)
+                    value /= (T)powers[-exponent];
+                else
+                    value *= (T)powers[exponent];
+                *(T*)ptr = negative ? -value : value;
+                return true;
+            }
+
+            inline bool ParseNumber(ValueKind kind, std::string_view text, void* ptr)
+            {
+                switch (kind)
+                {
+                    case ValueKind::S8: return ParseInteger<std::int8_t>(text, ptr);
+                    case ValueKind::S16: return ParseInteger<std::int16_t>(text, ptr);
+                    case ValueKind::S32: return ParseInteger<std::int32_t>(text, ptr);
+                    case ValueKind::S64: return ParseInteger<std::int64_t>(text, ptr);
+                    case ValueKind::U8: return ParseInteger<std::uint8_t>(text, ptr);
+                    case ValueKind::U16: return ParseInteger<std::uint16_t>(text, ptr);
+                    case ValueKind::U32: return ParseInteger<std::uint32_t>(text, ptr);
+                    case ValueKind::U64: return ParseInteger<std::uint64_t>(text, ptr);
+                    case ValueKind::F32: return ParseFloat<float>(text, ptr);
+                    case ValueKind::F64: return ParseFloat<double>(text, ptr);
+                    default: return false;
+                }
+            }
+
+            // enum from name, flags names or number
+            inline bool ParseEnum(const Plan& plan, std::string_view text, bool isNumber, void* ptr)
+            {
+                size_t value = InvalidIndex;
+                if (isNumber)
+                {
+                    std::int64_t number;
+                    if (!ParseInteger<std::int64_t>(text, &number))
+                        return false;
+                    value = (size_t)number;
+                }
+                else if (plan.Type->EnumFlags)
+                {
+                    if (!plan.Type->ParseEnumFlags(text, value))
+                        return false;
+                }
+                else
+                {
+                    // entry lookup, -1 value of signed enum is InvalidIndex
+                    const EnumEntry* entry = eti::internal::FindMember(plan.Type->EnumNameTable, text);
+                    if (entry == nullptr)
+                        return false;
+                    value = entry->Value;
+                }
+                StoreEnum(plan, ptr, value);
+                return true;
+            }
+        }
+
+        // built once per type, thread safe
+        inline const Plan& GetPlan(const Type& type)
+        {
+            std::lock_guard<std::recursive_mutex> lock(internal::GetPlansMutex());
+            return internal::GetPlanLocked(type);
+        }
+    }
+
+#pragma endregion
+
+#pragma region Json Writer
+
+    class JsonWriter
+    {
+    public:
+
+        // receive buffer content when it reach flush size, return false to stop writing
+        using WriteFunction = bool (*)(void* context, std::string_view data);
+
+        JsonWriter() = default;
+        JsonWriter(WriteFunction write, void* context, size_t flushSize = 64 * 1024)
+            : write(write), writeContext(context), flushSize(flushSize) {}
+
+        template<typename T>
+        bool Write(const T& obj)
+        {
+            return WriteObject(TypeOf<T>(), &obj);
+        }
+
+        bool WriteObject(const Type& type, const void* obj)
+        {
+            WriteValue(GetPlan(type), obj);
+            return Flush();
+        }
+
+        // send buffered data to WriteFunction (if any)
+        bool Flush()
+        {
+            if (write != nullptr && !buffer.empty())
+            {
+                ok = write(writeContext, buffer) && ok;
+                buffer.clear();
+            }
+            return ok;
+        }
+
+        std::string_view GetBuffer() const { return buffer; }
+        void Clear() { buffer.clear(); }
+
+    private:
+
+        const json::Plan& GetPlan(const Type& type)
+        {
+            if (lastPlan == nullptr || lastPlan->Type != &type)
+                lastPlan = &json::GetPlan(type);
+            return *lastPlan;
+        }
+
+        template<typename T>
+        void WriteNumber(T value)
+        {
+            char chars[32];
+            auto [last, error] = std::to_chars(chars, chars + sizeof(chars), value);
+            buffer.append(chars, last - chars);
+        }
+
+        template<typename T>
+        void WriteFloat(T value)
+        {
+            // json doesn't support nan and infinity
+            if (std::isfinite(value))
+                WriteNumber(value);
+            else
+                buffer.append("null");
+        }
+
+        void WriteString(std::string_view str)
+        {
+            buffer.push_back('"');
+            json::internal::AppendEscaped(buffer, str);
+            buffer.push_back('"');
+        }
+
+        // unnamed value is written as number (quoted for map key)
+        void WriteEnum(const json::Plan& plan, const void* obj, bool quoteNumber = false)
+        {
+            size_t value = json::internal::LoadEnum(plan, obj);
+            if (plan.Type->EnumFlags)
+            {
+                char chars[256];
+                size_t size = plan.Type->FormatEnumFlags(value, chars);
+                if (size != InvalidIndex)
+                {
+                    WriteString(std::string_view(chars, size));
+                    return;
+                }
+            }
+            else
+            {
+                std::string_view name = plan.Type->GetEnumValueName(value);
+                if (!name.empty())
+                {
+                    WriteString(name);
+                    return;
+                }
+            }
+            if (quoteNumber)
+                buffer.push_back('"');
+            if (plan.EnumSigned)
+                WriteNumber((std::int64_t)value);
+            else
+                WriteNumber((std::uint64_t)value);
+            if (quoteNumber)
+                buffer.push_back('"');
+        }
+
+        // map keys are always json strings
+        void WriteKey(const json::Plan& plan, const void* key)
+        {
+            if (plan.Kind == json::ValueKind::String)
+            {
+                WriteString(*static_cast<const std::string*>(key));
+            }
+            else if (plan.Kind == json::ValueKind::Enum)
+            {
+                WriteEnum(plan, key, true);
+            }
+            else
+            {
+                buffer.push_back('"');
+                WriteValue(plan, key);
+                buffer.push_back('"');
+            }
+            buffer.push_back(':');
+        }
+
+        void WriteValue(const json::Plan& plan, const void* obj)
+        {
+            switch (plan.Kind)
+            {
+                case json::ValueKind::None: buffer.append("null"); break;
+                case json::ValueKind::Bool: buffer.append(*(const bool*)obj ? "true" : "false"); break;
+                case json::ValueKind::S8: WriteNumber(*(const std::int8_t*)obj); break;
+                case json::ValueKind::S16: WriteNumber(*(const std::int16_t*)obj); break;
+                case json::ValueKind::S32: WriteNumber(*(const std::int32_t*)obj); break;
+                case json::ValueKind::S64: WriteNumber(*(const std::int64_t*)obj); break;
+                case json::ValueKind::U8: WriteNumber(*(const std::uint8_t*)obj); break;
+                case json::ValueKind::U16: WriteNumber(*(const std::uint16_t*)obj); break;
+                case json::ValueKind::U32: WriteNumber(*(const std::uint32_t*)obj); break;
+                case json::ValueKind::U64: WriteNumber(*(const std::uint64_t*)obj); break;
+                case json::ValueKind::F32: WriteFloat(*(const float*)obj); break;
+                case json::ValueKind::F64: WriteFloat(*(const double*)obj); break;
+                case json::ValueKind::Enum: WriteEnum(plan, obj); break;
+                case json::ValueKind::String: WriteString(*(const std::string*)obj); break;
+                case json::ValueKind::Object: WriteFields(plan, obj); break;
+                case json::ValueKind::Vector: WriteVector(plan, const_cast<void*>(obj)); break;
+                case json::ValueKind::Map: WriteMap(plan, const_cast<void*>(obj)); break;
+            }
+        }
+
+        void WriteFields(const json::Plan& plan, const void* obj)
+        {
+            const std::byte* bytes = static_cast<const std::byte*>(obj);
+            buffer.push_back('{');
+            for (size_t i = 0; i < plan.Fields.size(); ++i)
+            {
+                const json::Field& field = plan.Fields[i];
+                if (i != 0)
+                    buffer.push_back(',');
+                buffer.append(field.Key);
+                WriteValue(*field.Value, bytes + field.Offset);
+            }
+            buffer.push_back('}');
+        }
+
+        void WriteVector(const json::Plan& plan, void* vector)
+        {
+            size_t size = 0;
+            std::byte* data = nullptr;
+            plan.GetSize->UnSafeCall(vector, &size, {});
+            plan.Access->UnSafeCall(vector, &data, {});
+
+            buffer.push_back('[');
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (i != 0)
+                    buffer.push_back(',');
+                WriteValue(*plan.Element, data + i * plan.ElementSize);
+                // large arrays are streamed
+                if (write != nullptr && buffer.size() >= flushSize)
+                    Flush();
+            }
+            buffer.push_back(']');
+        }
+
+        struct MapVisitContext
+        {
+            JsonWriter* Writer;
+            const json::Plan* Plan;
+            bool First;
+        };
+
+        void WriteMap(const json::Plan& plan, void* map)
+        {
+            MapVisitContext context = { this, &plan, true };
+            utils::MapVisitFunction visit = [](void* context, const void* key, void* value)
+            {
+                MapVisitContext& visitContext = *static_cast<MapVisitContext*>(context);
+                JsonWriter& writer = *visitContext.Writer;
+                if (!visitContext.First)
+                    writer.buffer.push_back(',');
+                visitContext.First = false;
+                writer.WriteKey(*visitContext.Plan->Key, key);
+                writer.WriteValue(*visitContext.Plan->Element, value);
+            };
+            void* contextPtr = &context;
+            void* visitArgs[] = { &visit, &contextPtr };
+
+            buffer.push_back('{');
+            plan.Access->UnSafeCall(map, NoReturn, visitArgs);
+            buffer.push_back('}');
+        }
+
+        std::string buffer;
+        const json::Plan* lastPlan = nullptr;
+
+        WriteFunction write = nullptr;
+        void* writeContext = nullptr;
+        size_t flushSize = 0;
+        bool ok = true;
+    };
+
+#pragma endregion
+
+#pragma region Json Reader
+
+    enum class JsonToken : std::uint8_t
+    {
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Key,        // GetText(): unescaped key
+        String,     // GetText(): unescaped string
+        Number,     // GetText(): number as written
+        True,
+        False,
+        Null,
+        End,        // end of input, after the single root value
+        Error       // invalid json or truncated input, sticky
+    };
+
+    class JsonReader
+    {
+    public:
+
+        // fill buffer with next chunk of input, return size read, 0 at end of input
+        using ReadFunction = size_t (*)(void* context, char* buffer, size_t size);
+
+        JsonReader(std::string_view json)
+            : data(json.data()), size(json.size()), eof(true) {}
+
+        JsonReader(ReadFunction read, void* context, size_t chunkSize = 64 * 1024)
+            : read(read), readContext(context), chunk(std::max(chunkSize, json::internal::ScanBlockSize))
+        {
+            data = chunk.data();
+        }
+
+        template<typename T>
+        bool Read(T& obj)
+        {
+            return ReadObject(TypeOf<T>(), &obj);
+        }
+
+        // read root value into obj, properties not in json keep their value, unknown keys are skipped
+        bool ReadObject(const Type& type, void* obj)
+        {
+            return ReadValue(GetPlan(type), obj, Next()) && Next() == JsonToken::End;
+        }
+
+        // pull next token, text of Key, String and Number is valid until next call
+        JsonToken Next()
+        {
+            if (error)
+                return JsonToken::Error;
+
+            tokenStart = NoToken;
+            size_t position;
+            if (!NextStructural(position))
+                return Fail();
+            if (position == size)
+                return stack.empty() && needSeparator ? JsonToken::End : Fail();
+
+            if (stack.empty())
+            {
+                // single root value
+                if (needSeparator)
+                    return Fail();
+                return NextValue(position);
+            }
+
+            char c = data[position];
+            if (stack.back() == '{')
+            {
+                if (afterKey)
+                {
+                    afterKey = false;
+                    if (c != ':' || !NextStructural(position) || position == size)
+                        return Fail();
+                    return NextValue(position);
+                }
+                if (c == '}')
+                    return EndContainer();
+                if (needSeparator && (c != ',' || !NextStructural(position) || position == size))
+                    return Fail();
+                if (data[position] != '"' || !ReadString(position))
+                    return Fail();
+                afterKey = true;
+                return JsonToken::Key;
+            }
+
+            if (c == ']')
+                return EndContainer();
+            if (needSeparator && (c != ',' || !NextStructural(position) || position == size))
+                return Fail();
+            return NextValue(position);
+        }
+
+        std::string_view GetText() const { return text; }
+        bool HasError() const { return error; }
+
+        // skip value starting at token (nested objects/arrays included)
+        bool Skip(JsonToken token)
+        {
+            if (token == JsonToken::BeginObject || token == JsonToken::BeginArray)
+            {
+                size_t depth = stack.size() - 1;
+                while (stack.size() > depth)
+                {
+                    if (Next() == JsonToken::Error)
+                        return false;
+                }
+                return true;
+            }
+            return token != JsonToken::Error && token != JsonToken::End && token != JsonToken::Key &&
+                token != JsonToken::EndObject && token != JsonToken::EndArray;
+        }
+
+    private:
+
+        static constexpr size_t NoToken = std::numeric_limits<size_t>::max();
+
+        const json::Plan& GetPlan(const Type& type)
+        {
+            if (lastPlan == nullptr || lastPlan->Type != &type)
+                lastPlan = &json::GetPlan(type);
+            return *lastPlan;
+        }
+
+        JsonToken Fail()
+        {
+            error = true;
+            return JsonToken::Error;
+        }
+
+        // Fail for typed reads
+        bool FailRead()
+        {
+            Fail();
+            return false;
+        }
+
+        // next structural offset, size at end of input (not consumed)
+        bool NextStructural(size_t& position, bool consume = true)
+        {
+            if (structurals == 0 && !ScanMore())
+            {
+                position = size;
+                return true;
+            }
+            position = blockOffset + (size_t)std::countr_zero(structurals);
+            if (consume)
+                structurals &= structurals - 1;
+            return true;
+        }
+
+        // scan blocks until one has structurals (consumed bit by bit in NextStructural), false at end of input
+        bool ScanMore()
+        {
+            do
+            {
+                if (size - scanned >= json::internal::ScanBlockSize)
+                {
+                    structurals = scanner.ScanStructurals(data + scanned);
+                }
+                else if (eof)
+                {
+                    if (scanned == size)
+                        return false;
+                    // last block padded with spaces
+                    char block[json::internal::ScanBlockSize];
+                    std::memset(block, ' ', sizeof(block));
+                    std::memcpy(block, data + scanned, size - scanned);
+                    structurals = scanner.ScanStructurals(block);
+                }
+                else
+                {
+                    Refill();
+                    continue;
+                }
+                blockOffset = scanned;
+                scanned = std::min(scanned + json::internal::ScanBlockSize, size);
+            } while (structurals == 0);
+            return true;
+        }
+
+        // keep current token and not scanned bytes, then append next chunk
+        void Refill()
+        {
+            size_t keep = std::min(tokenStart, scanned);
+            std::memmove(chunk.data(), chunk.data() + keep, size - keep);
+            size -= keep;
+            scanned -= keep;
+            if (tokenStart != NoToken)
+                tokenStart -= keep;
+
+            if (size == chunk.size())
+                chunk.resize(chunk.size() * 2);
+            data = chunk.data();
+
+            size_t count = read(readContext, chunk.data() + size, chunk.size() - size);
+            size += count;
+            eof = count == 0;
+        }
+
+        JsonToken EndContainer()
+        {
+            char c = stack.back();
+            stack.pop_back();
+            needSeparator = true;
+            return c == '{' ? JsonToken::EndObject : JsonToken::EndArray;
+        }
+
+        JsonToken NextValue(size_t position)
+        {
+            needSeparator = true;
+            char c = data[position];
+            switch (c)
+            {
+                case '{':
+                case '[':
+                    stack.push_back(c);
+                    needSeparator = false;
+                    return c == '{' ? JsonToken::BeginObject : JsonToken::BeginArray;
+                case '"':
+                    return ReadString(position) ? JsonToken::String : Fail();
+                case 't':
+                    return ReadScalar(position) && text == "true" ? JsonToken::True : Fail();
+                case 'f':
+                    return ReadScalar(position) && text == "false" ? JsonToken::False : Fail();
+                case 'n':
+                    return ReadScalar(position) && text == "null" ? JsonToken::Null : Fail();
+                default:
+                    // number text is validated when converted (see json::internal::ParseNumber)
+                    if ((c == '-' || (c >= '0' && c <= '9')) && ReadScalar(position))
+                        return JsonToken::Number;
+                    return Fail();
+            }
+        }
+
+        // number or literal, end at next structural
+        bool ReadScalar(size_t position)
+        {
+            tokenStart = position;
+            size_t last;
+            if (!NextStructural(last, false))
+                return false;
+            position = tokenStart;
+            while (last > position && (data[last - 1] == ' ' || data[last - 1] == '\n' || data[last - 1] == '\r' || data[last - 1] == '\t'))
+                --last;
+            text = std::string_view(data + position, last - position);
+            return true;
+        }
+
+        static int HexValue(char c)
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        static bool ReadHex(const char*& ptr, const char* last, std::uint32_t& value)
+        {
+            if (last - ptr < 4)
+                return false;
+            value = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                int digit = HexValue(*ptr++);
+                if (digit < 0)
+                    return false;
+                value = (value << 4) | (std::uint32_t)digit;
+            }
+            return true;
+        }
+
+        void AppendUtf8(std::uint32_t code)
+        {
+            if (code < 0x80)
+            {
+                scratch.push_back((char)code);
+            }
+            else if (code < 0x800)
+            {
+                scratch.push_back((char)(0xC0 | (code >> 6)));
+                scratch.push_back((char)(0x80 | (code & 0x3F)));
+            }
+            else if (code < 0x10000)
+            {
+                scratch.push_back((char)(0xE0 | (code >> 12)));
+                scratch.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+                scratch.push_back((char)(0x80 | (code & 0x3F)));
+            }
+            else
+            {
+                scratch.push_back((char)(0xF0 | (code >> 18)));
+                scratch.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+                scratch.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+                scratch.push_back((char)(0x80 | (code & 0x3F)));
+            }
+        }
+
+        // ptr is after '\\'
+        bool ReadEscape(const char*& ptr, const char* last)
+        {
+            if (ptr == last)
+                return false;
+            switch (*ptr++)
+            {
+                case '"': scratch.push_back('"'); return true;
+                case '\\': scratch.push_back('\\'); return true;
+                case '/': scratch.push_back('/'); return true;
+                case 'b': scratch.push_back('\b'); return true;
+                case 'f': scratch.push_back('\f'); return true;
+                case 'n': scratch.push_back('\n'); return true;
+                case 'r': scratch.push_back('\r'); return true;
+                case 't': scratch.push_back('\t'); return true;
+                case 'u':
+                {
+                    std::uint32_t code;
+                    if (!ReadHex(ptr, last, code))
+                        return false;
+                    // surrogate pair
+                    if (code >= 0xD800 && code <= 0xDBFF)
+                    {
+                        std::uint32_t low;
+                        if (last - ptr < 2 || ptr[0] != '\\' || ptr[1] != 'u')
+                            return false;
+                        ptr += 2;
+                        if (!ReadHex(ptr, last, low) || low < 0xDC00 || low > 0xDFFF)
+                            return false;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    AppendUtf8(code);
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        }
+
+        // position is opening quote, closing quote is next structural
+        bool ReadString(size_t position)
+        {
+            tokenStart = position;
+            size_t last;
+            return NextStructural(last) && last != size && UnescapeString(last);
+        }
+
+        // text of string from tokenStart (opening quote) to last (closing quote)
+        bool UnescapeString(size_t last)
+        {
+            const char* first = data + tokenStart + 1;
+            const char* end = data + last;
+
+            // fast path, no escape: text point in input
+            const char* ptr = json::internal::FindEscape(first, end);
+            if (ptr == end)
+            {
+                text = std::string_view(first, end - first);
+                return true;
+            }
+
+            scratch.assign(first, ptr);
+            while (ptr != end)
+            {
+                if (*ptr != '\\')
+                    return false;
+                if (!ReadEscape(++ptr, end))
+                    return false;
+                const char* next = json::internal::FindEscape(ptr, end);
+                scratch.append(ptr, next);
+                ptr = next;
+            }
+            text = scratch;
+            return true;
+        }
+
+        bool ReadValue(const json::Plan& plan, void* obj, JsonToken token)
+        {
+            // null keep current value
+            if (token == JsonToken::Null)
+                return true;
+
+            switch (plan.Kind)
+            {
+                case json::ValueKind::None:
+                    return Skip(token);
+                case json::ValueKind::Bool:
+                    if (token != JsonToken::True && token != JsonToken::False)
+                        return false;
+                    *(bool*)obj = token == JsonToken::True;
+                    return true;
+                case json::ValueKind::Enum:
+                    return (token == JsonToken::String || token == JsonToken::Number) && json::internal::ParseEnum(plan, text, token == JsonToken::Number, obj);
+                case json::ValueKind::String:
+                    if (token != JsonToken::String)
+                        return false;
+                    ((std::string*)obj)->assign(text);
+                    return true;
+                case json::ValueKind::Object:
+                    return token == JsonToken::BeginObject && ReadFields(plan, obj);
+                case json::ValueKind::Vector:
+                    return token == JsonToken::BeginArray && ReadVector(plan, obj);
+                case json::ValueKind::Map:
+                    return token == JsonToken::BeginObject && ReadMap(plan, obj);
+                default:
+                    return token == JsonToken::Number && json::internal::ParseNumber(plan.Kind, text, obj);
+            }
+        }
+
+        // value starting at structural position, numbers are parsed in place (no token)
+        bool ReadValueAt(const json::Plan& plan, void* obj, size_t position)
+        {
+            char c = data[position];
+            if (plan.Kind >= json::ValueKind::S8 && plan.Kind <= json::ValueKind::F64 && (c == '-' || (c >= '0' && c <= '9')))
+            {
+                needSeparator = true;
+                return ReadScalar(position) && json::internal::ParseNumber(plan.Kind, text, obj);
+            }
+            return ReadValue(plan, obj, NextValue(position));
+        }
+
+        // next element or field position of open container (after separator), false at its end or on error
+        bool NextMember(size_t& position, char end, bool& valid)
+        {
+            tokenStart = NoToken;
+            valid = NextStructural(position) && position != size;
+            if (!valid)
+                return FailRead();
+            if (data[position] == end)
+            {
+                EndContainer();
+                return false;
+            }
+            if (needSeparator && (data[position] != ',' || !NextStructural(position) || position == size))
+            {
+                valid = false;
+                return FailRead();
+            }
+            return true;
+        }
+
+        // fields read from structurals (same grammar as Next), keys in plan order are matched without hash
+        bool ReadFields(const json::Plan& plan, void* obj)
+        {
+            std::byte* bytes = static_cast<std::byte*>(obj);
+            size_t expected = 0;
+            size_t position;
+            bool valid;
+            while (NextMember(position, '}', valid))
+            {
+                size_t last;
+                tokenStart = position;
+                if (data[position] != '"' || !NextStructural(last) || last == size)
+                    return FailRead();
+
+                // expected name is compared with raw key (names have no escape), else key is unescaped and hashed
+                const json::Field* field = nullptr;
+                if (expected < plan.Fields.size() && plan.Fields[expected].Name == std::string_view(data + tokenStart + 1, last - tokenStart - 1))
+                    field = &plan.Fields[expected];
+                else if (UnescapeString(last))
+                    field = eti::internal::FindMember(plan.FieldTable, utils::GetStringHash(text));
+                else
+                    return FailRead();
+
+                if (!NextStructural(position) || position == size || data[position] != ':' || !NextStructural(position) || position == size)
+                    return FailRead();
+                if (field != nullptr)
+                {
+                    expected = (size_t)(field - plan.Fields.data()) + 1;
+                    valid = ReadValueAt(*field->Value, bytes + field->Offset, position);
+                }
+                else
+                {
+                    valid = Skip(NextValue(position));
+                }
+                if (!valid)
+                    return false;
+            }
+            return valid;
+        }
+
+        bool ReadVector(const json::Plan& plan, void* vector)
+        {
+            plan.Clear->UnSafeCall(vector, NoReturn, {});
+            size_t position;
+            bool valid;
+            while (NextMember(position, ']', valid))
+            {
+                void* element = nullptr;
+                plan.Insert->UnSafeCall(vector, &element, {});
+                if (!ReadValueAt(*plan.Element, element, position))
+                    return false;
+            }
+            return valid;
+        }
+
+        bool ReadKey(const json::Plan& plan, void* key)
+        {
+            switch (plan.Kind)
+            {
+                case json::ValueKind::String:
+                    ((std::string*)key)->assign(text);
+                    return true;
+                case json::ValueKind::Enum:
+                {
+                    bool isNumber = !text.empty() && (text[0] == '-' || (text[0] >= '0' && text[0] <= '9'));
+                    return json::internal::ParseEnum(plan, text, isNumber, key);
+                }
+                default:
+                    return json::internal::ParseNumber(plan.Kind, text, key);
+            }
+        }
+
+        bool ReadMap(const json::Plan& plan, void* map)
+        {
+            plan.Clear->UnSafeCall(map, NoReturn, {});
+
+            // key is read in a single temporary, then inserted
+            void* key = nullptr;
+            bool valid = true;
+            for (;;)
+            {
+                JsonToken token = Next();
+                if (token == JsonToken::EndObject)
+                    break;
+                if (key == nullptr)
+                    key = plan.Key->Type->New();
+                valid = token == JsonToken::Key && ReadKey(*plan.Key, key);
+                if (!valid)
+                    break;
+
+                void* value = nullptr;
+                void* insertArgs[] = { &key };
+                plan.Insert->UnSafeCall(map, &value, insertArgs);
+                valid = ReadValue(*plan.Element, value, Next());
+                if (!valid)
+                    break;
+            }
+            if (key != nullptr)
+                plan.Key->Type->Delete(key);
+            return valid;
+        }
+
+        // input, chunk is the buffer when reading from ReadFunction
+        const char* data = nullptr;
+        size_t size = 0;
+        bool eof = false;
+        ReadFunction read = nullptr;
+        void* readContext = nullptr;
+        std::vector<char> chunk;
+
+        // structurals of current block (bit i: blockOffset + i), scanned by blocks
+        json::internal::StructuralScanner scanner;
+        std::uint64_t structurals = 0;
+        size_t blockOffset = 0;
+        size_t scanned = 0;
+        // start of current token, kept in chunk on refill
+        size_t tokenStart = NoToken;
+
+        std::string_view text;
+        std::string scratch;
+
+        // open containers, '{' or '['
+        std::vector<char> stack;
+        bool needSeparator = false;
+        bool afterKey = false;
+        bool error = false;
+
+        const json::Plan* lastPlan = nullptr;
+    };
+
+#pragma endregion
+
+}
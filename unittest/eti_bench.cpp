@@ -0,0 +1,1290 @@
+//  MIT License
+//
+//  Copyright (c) 2024 Eric Thiffeault
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+// eti micro benchmarks, no external dependencies
+//
+//  build: clang++ -I . -std=c++20 -O2 -o bench.exe ./unittest/eti_bench.cpp
+//
+//  usage: bench.exe [--filter <group substring>] [--json <file>] [--generate <file>]
+//      print ns/op and allocations/op (and MB/s for throughput) of each benchmark, grouped with their native baseline
+//      --json write all results in machine readable format (to track regressions)
+//      --generate write json throughput dataset to file (for external parsers comparison)
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include <eti/eti.h>
+#include <eti/eti_archive.h>
+#include <eti/eti_binary.h>
+#include <eti/eti_json.h>
+
+ETI_REPOSITORY_IMPL()
+
+using namespace eti;
+
+namespace bench
+{
+    using Clock = std::chrono::steady_clock;
+
+    // sink used to keep benchmarked results alive
+    volatile std::size_t Sink = 0;
+
+    // read and write of Sink (compound assignment of volatile is deprecated in c++20)
+    inline void Consume(std::size_t value)
+    {
+        Sink = Sink + value;
+    }
+
+    // global allocations count (see operator new below)
+    std::atomic<std::size_t> Allocations = 0;
+
+    struct Result
+    {
+        std::string Group;
+        std::string Name;
+        double NsPerOp = 0.0;
+        double AllocationsPerOp = 0.0;
+        double MBPerSecond = 0.0;
+    };
+
+    std::vector<Result> Results;
+    std::string CurrentGroup;
+    std::string_view Filter;
+
+    // start a group of benchmarks, false if filtered out
+    bool Group(std::string_view name)
+    {
+        if (!Filter.empty() && name.find(Filter) == std::string_view::npos)
+        {
+            CurrentGroup.clear();
+            return false;
+        }
+        CurrentGroup = name;
+        std::cout << name << std::endl;
+        return true;
+    }
+
+    // bytes: size processed by one call of func, to report throughput
+    template<typename FUNC>
+    double Run(std::string_view name, std::size_t iterations, FUNC&& func, std::size_t bytes = 0)
+    {
+        if (CurrentGroup.empty())
+            return 0.0;
+
+        // warmup
+        for (std::size_t i = 0; i < iterations / 10; ++i)
+            func();
+
+        std::size_t allocations = Allocations.load(std::memory_order_relaxed);
+        Clock::time_point start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            func();
+        Clock::time_point end = Clock::now();
+        allocations = Allocations.load(std::memory_order_relaxed) - allocations;
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / (double)iterations;
+        double allocationsPerOp = (double)allocations / (double)iterations;
+        double mbPerSecond = (double)bytes / ns * 1000.0;
+        std::cout << "    " << name << ": " << ns << " ns/op, " << allocationsPerOp << " allocs/op";
+        if (bytes != 0)
+            std::cout << ", " << mbPerSecond << " MB/s";
+        std::cout << std::endl;
+        Results.push_back({ CurrentGroup, std::string(name), ns, allocationsPerOp, mbPerSecond });
+        return ns;
+    }
+
+    std::string JsonEscape(std::string_view str)
+    {
+        std::string escaped;
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    bool WriteJson(const std::string& path)
+    {
+        std::ofstream file(path);
+        if (!file)
+            return false;
+        file << "{\n    \"results\":\n    [\n";
+        for (std::size_t i = 0; i < Results.size(); ++i)
+        {
+            const Result& result = Results[i];
+            file << "        { \"group\": \"" << JsonEscape(result.Group) << "\", \"name\": \"" << JsonEscape(result.Name)
+                << "\", \"ns_per_op\": " << result.NsPerOp << ", \"allocs_per_op\": " << result.AllocationsPerOp
+                << ", \"mb_per_s\": " << result.MBPerSecond << " }"
+                << (i + 1 < Results.size() ? ",\n" : "\n");
+        }
+        file << "    ]\n}\n";
+        return true;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    bench::Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    bench::Allocations.fetch_add(1, std::memory_order_relaxed);
+#if defined(_WIN32)
+    if (void* ptr = _aligned_malloc(size, (std::size_t)align))
+        return ptr;
+#else
+    if (void* ptr = std::aligned_alloc((std::size_t)align, (size + (std::size_t)align - 1) & ~((std::size_t)align - 1)))
+        return ptr;
+#endif
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept
+{
+    operator delete(ptr, align);
+}
+
+namespace bench_core
+{
+    class Base
+    {
+        ETI_BASE(Base)
+    public:
+        virtual ~Base() {}
+        virtual int GetValueVirtual() const { return 0; }
+    };
+
+    class Foo : public Base
+    {
+        ETI_CLASS_EXT(Foo, Base,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Value),
+                ETI_PROPERTY(Name)
+            ),
+            ETI_METHODS
+            (
+                ETI_METHOD(Add),
+                ETI_METHOD(GetValue)
+            ))
+    public:
+        int Add(int n) { Value += n; return Value; }
+        int GetValue() const { return Value; }
+        int GetValueVirtual() const override { return Value; }
+
+        int Value = 0;
+        std::string Name = "foo";
+    };
+
+    class Doo : public Base
+    {
+        ETI_CLASS(Doo, Base)
+    };
+
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000'000;
+
+        Foo foo;
+        Doo doo;
+        Base* objects[] = { &foo, &doo };
+        std::size_t i = 0;
+
+        if (bench::Group("TypeOf"))
+        {
+            bench::Run("eti::TypeOf<Foo>()", iterations, [&]()
+            {
+                bench::Consume((std::size_t)&TypeOf<Foo>());
+            });
+            bench::Run("native typeid(Foo)", iterations, [&]()
+            {
+                bench::Consume((std::size_t)&typeid(Foo));
+            });
+            bench::Run("eti instance GetType()", iterations, [&]()
+            {
+                bench::Consume((std::size_t)&objects[i++ & 1]->GetType());
+            });
+            bench::Run("native typeid(instance)", iterations, [&]()
+            {
+                bench::Consume((std::size_t)&typeid(*objects[i++ & 1]));
+            });
+        }
+
+        if (bench::Group("IsA"))
+        {
+            bench::Run("eti::IsA<Foo>(instance)", iterations, [&]()
+            {
+                bench::Consume(IsA<Foo>(*objects[i++ & 1]));
+            });
+            bench::Run("native dynamic_cast<Foo*> != nullptr", iterations, [&]()
+            {
+                bench::Consume(dynamic_cast<Foo*>(objects[i++ & 1]) != nullptr);
+            });
+        }
+
+        if (bench::Group("Cast"))
+        {
+            bench::Run("eti::Cast<Foo>(Base*)", iterations, [&]()
+            {
+                bench::Consume((std::size_t)Cast<Foo>(objects[i++ & 1]));
+            });
+            bench::Run("native dynamic_cast<Foo*>(Base*)", iterations, [&]()
+            {
+                bench::Consume((std::size_t)dynamic_cast<Foo*>(objects[i++ & 1]));
+            });
+        }
+
+        const Type& type = TypeOf<Foo>();
+        std::string_view names[] = { "Value", "Name" };
+        if (bench::Group("GetProperty"))
+        {
+            TypeId ids[] = { type.GetProperty("Value")->PropertyId, type.GetProperty("Name")->PropertyId };
+            std::unordered_map<std::string_view, const Property*> properties;
+            for (const Property& property : type.Properties)
+                properties[property.Variable.Name] = &property;
+
+            bench::Run("eti Type::GetProperty(name)", iterations, [&]()
+            {
+                bench::Consume((std::size_t)type.GetProperty(names[i++ & 1]));
+            });
+            bench::Run("eti Type::GetProperty(id)", iterations, [&]()
+            {
+                bench::Consume((std::size_t)type.GetProperty(ids[i++ & 1]));
+            });
+            bench::Run("native std::unordered_map find(name)", iterations, [&]()
+            {
+                bench::Consume((std::size_t)properties.find(names[i++ & 1])->second);
+            });
+        }
+
+        const Property& valueProperty = *type.GetProperty("Value");
+        if (bench::Group("Property Get/Set"))
+        {
+            bench::Run("eti Property::Get(int)", iterations, [&]()
+            {
+                int value = 0;
+                valueProperty.Get(foo, value);
+                bench::Consume((std::size_t)value);
+            });
+            bench::Run("native member read", iterations, [&]()
+            {
+                bench::Consume((std::size_t)foo.Value);
+            });
+            bench::Run("eti Property::Set(int)", iterations, [&]()
+            {
+                valueProperty.Set(foo, (int)i++);
+                bench::Consume((std::size_t)foo.Value);
+            });
+            bench::Run("native member write", iterations, [&]()
+            {
+                foo.Value = (int)i++;
+                bench::Consume((std::size_t)foo.Value);
+            });
+        }
+
+        const Method& addMethod = *type.GetMethod("Add");
+        if (bench::Group("CallMethod"))
+        {
+            bench::Run("eti Method::CallMethod(Add)", iterations, [&]()
+            {
+                int ret = 0;
+                addMethod.CallMethod(foo, &ret, 1);
+                bench::Consume((std::size_t)ret);
+            });
+            bench::Run("native call Add", iterations, [&]()
+            {
+                bench::Consume((std::size_t)foo.Add(1));
+            });
+            bench::Run("native virtual call", iterations, [&]()
+            {
+                bench::Consume((std::size_t)objects[i++ & 1]->GetValueVirtual());
+            });
+        }
+
+        if (bench::Group("UnSafeCall"))
+        {
+            int n = 1;
+            int ret = 0;
+            void* argsPtr[] = { &n };
+            std::span<void*> args = argsPtr;
+            bench::Run("eti Method::UnSafeCall(Add)", iterations, [&]()
+            {
+                addMethod.UnSafeCall(&foo, &ret, args);
+                bench::Consume((std::size_t)ret);
+            });
+            bench::Run("native call Add", iterations, [&]()
+            {
+                bench::Consume((std::size_t)foo.Add(n));
+            });
+        }
+    }
+}
+
+namespace bench_type_functions
+{
+    struct Foo
+    {
+        ETI_STRUCT_EXT(Foo, ETI_PROPERTIES(), ETI_METHODS(ETI_METHOD(Add)))
+
+        int Add(int n) { Value += n; return Value; }
+
+        int Value = 0;
+        std::string Name = "foo";
+    };
+
+    // previous representation of Type/Method functions
+    struct StdFunctions
+    {
+        std::function<void(void* /* dst */)> Construct;
+        std::function<void(void* /* src */, void* /* dst */)> CopyConstruct;
+        std::function<void(void* /* dst */)> Destruct;
+        std::function<void(void*, void*, std::span<void*>)> Function;
+    };
+
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000'000;
+
+        const Type& type = TypeOf<Foo>();
+        const Method& method = *type.GetMethod("Add");
+
+        StdFunctions functions
+        {
+            type.Construct,
+            type.CopyConstruct,
+            type.Destruct,
+            method.Function
+        };
+
+        if (!bench::Group("type functions (function pointer vs std::function)"))
+            return;
+        std::cout << "    sizeof(Type): " << sizeof(Type) << ", sizeof(Method): " << sizeof(Method) << ", sizeof(std::function): " << sizeof(std::function<void(void*)>) << std::endl;
+
+        alignas(Foo) char src[sizeof(Foo)];
+        alignas(Foo) char dst[sizeof(Foo)];
+
+        bench::Run("Type::Construct/Destruct function pointer", iterations, [&]()
+        {
+            type.Construct(dst);
+            type.Destruct(dst);
+        });
+        bench::Run("Type::Construct/Destruct std::function", iterations, [&]()
+        {
+            functions.Construct(dst);
+            functions.Destruct(dst);
+        });
+
+        type.Construct(src);
+        bench::Run("Type::CopyConstruct/Destruct function pointer", iterations, [&]()
+        {
+            type.CopyConstruct(src, dst);
+            type.Destruct(dst);
+        });
+        bench::Run("Type::CopyConstruct/Destruct std::function", iterations, [&]()
+        {
+            functions.CopyConstruct(src, dst);
+            functions.Destruct(dst);
+        });
+        type.Destruct(src);
+
+        Foo foo;
+        int n = 1;
+        int ret = 0;
+        void* argsPtr[] = { &n };
+        std::span<void*> args = argsPtr;
+        bench::Run("Method::Function function pointer", iterations, [&]()
+        {
+            method.Function(&foo, &ret, args);
+            bench::Consume((std::size_t)ret);
+        });
+        bench::Run("Method::Function std::function", iterations, [&]()
+        {
+            functions.Function(&foo, &ret, args);
+            bench::Consume((std::size_t)ret);
+        });
+    }
+}
+
+namespace bench_isa
+{
+    class L0
+    {
+        ETI_BASE(L0)
+    public:
+        virtual ~L0() {}
+    };
+
+    #define BENCH_ISA_LEVEL(N, PARENT) \
+        class L##N : public PARENT \
+        { \
+            ETI_CLASS(L##N, PARENT) \
+        };
+
+    BENCH_ISA_LEVEL(1, L0)
+    BENCH_ISA_LEVEL(2, L1)
+    BENCH_ISA_LEVEL(3, L2)
+    BENCH_ISA_LEVEL(4, L3)
+    BENCH_ISA_LEVEL(5, L4)
+    BENCH_ISA_LEVEL(6, L5)
+    BENCH_ISA_LEVEL(7, L6)
+    BENCH_ISA_LEVEL(8, L7)
+    BENCH_ISA_LEVEL(9, L8)
+    BENCH_ISA_LEVEL(10, L9)
+    BENCH_ISA_LEVEL(11, L10)
+    BENCH_ISA_LEVEL(12, L11)
+    BENCH_ISA_LEVEL(13, L12)
+    BENCH_ISA_LEVEL(14, L13)
+    BENCH_ISA_LEVEL(15, L14)
+    BENCH_ISA_LEVEL(16, L15)
+
+    // previous IsA implementation, walk parents
+    bool ParentsIsA(const Type& type, const Type& base)
+    {
+        const Type* cur = &type;
+        while (cur != nullptr)
+        {
+            if (*cur == base)
+                return true;
+            cur = cur->Parent;
+        }
+        return false;
+    }
+
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000'000;
+
+        L1 l1; L2 l2; L3 l3; L4 l4; L5 l5; L6 l6; L7 l7; L8 l8;
+        L9 l9; L10 l10; L11 l11; L12 l12; L13 l13; L14 l14; L15 l15; L16 l16;
+        L0* objects[] = { &l1, &l2, &l3, &l4, &l5, &l6, &l7, &l8, &l9, &l10, &l11, &l12, &l13, &l14, &l15, &l16 };
+
+        // cast instance of depth N (as L0*) to L1, parents walk is N - 1 steps
+        // ancestors display vs parents walk vs dynamic_cast
+        for (std::size_t depth = 1; depth <= 16; ++depth)
+        {
+            L0* object = objects[depth - 1];
+            if (!bench::Group("Cast<L1>(L0*) instance depth " + std::to_string(depth)))
+                continue;
+            bench::Run("eti::Cast", iterations, [&]()
+            {
+                bench::Consume((std::size_t)Cast<L1>(object));
+            });
+            bench::Run("parents walk", iterations, [&]()
+            {
+                bench::Consume((std::size_t)(ParentsIsA(object->GetType(), TypeOf<L1>()) ? static_cast<L1*>(object) : nullptr));
+            });
+            bench::Run("dynamic_cast", iterations, [&]()
+            {
+                bench::Consume((std::size_t)dynamic_cast<L1*>(object));
+            });
+        }
+    }
+}
+
+namespace bench_repository
+{
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000'000;
+
+        // builtin types, std types used by reflection are registered at this point
+        const Type* types[] = { &TypeOf<bool>(), &TypeOf<int>(), &TypeOf<float>(), &TypeOf<double>(), &TypeOf<std::string>(), &TypeOf<bench_isa::L16>(), &TypeOf<bench_type_functions::Foo>() };
+        constexpr std::size_t typeCount = std::size(types);
+
+        // previous repository index
+        std::map<TypeId, const Type*> idToTypes;
+        std::map<std::string_view, const Type*> namesToTypes;
+        for (const Type* type : types)
+        {
+            idToTypes[type->Id] = type;
+            namesToTypes[type->Name] = type;
+        }
+        // filled like a real program registry
+        std::deque<std::string> names;
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            std::string_view name = names.emplace_back("bench_repository::Type" + std::to_string(i));
+            idToTypes[utils::GetStringHash(name)] = nullptr;
+            namesToTypes[name] = nullptr;
+        }
+
+        if (!bench::Group("Repository::GetType (open addressing vs std::map)"))
+            return;
+        std::cout << "    registered types: " << Repository::Instance().GetTypeCount() << std::endl;
+        std::size_t i = 0;
+        bench::Run("Repository::GetType(id)", iterations, [&]()
+        {
+            bench::Consume((std::size_t)Repository::Instance().GetType(types[i++ % typeCount]->Id));
+        });
+        bench::Run("std::map<TypeId> find", iterations, [&]()
+        {
+            bench::Consume((std::size_t)idToTypes.find(types[i++ % typeCount]->Id)->second);
+        });
+        bench::Run("Repository::GetType(name)", iterations, [&]()
+        {
+            bench::Consume((std::size_t)Repository::Instance().GetType(types[i++ % typeCount]->Name));
+        });
+        bench::Run("std::map<std::string_view> find", iterations, [&]()
+        {
+            bench::Consume((std::size_t)namesToTypes.find(types[i++ % typeCount]->Name)->second);
+        });
+    }
+}
+
+namespace bench_type_index
+{
+    // per type counters, like an event dispatcher or per type allocator stats
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000'000;
+
+        const Type* types[] = { &TypeOf<bool>(), &TypeOf<int>(), &TypeOf<float>(), &TypeOf<double>(), &TypeOf<std::string>(), &TypeOf<bench_isa::L16>(), &TypeOf<bench_type_functions::Foo>() };
+        constexpr std::size_t typeCount = std::size(types);
+
+        if (!bench::Group("per type side table (Type::Index vs std::unordered_map<TypeId>)"))
+            return;
+        std::size_t i = 0;
+        std::vector<std::size_t> counters(GetTypeIndexCount());
+        bench::Run("std::vector[Type::Index]", iterations, [&]()
+        {
+            bench::Consume(++counters[types[i++ % typeCount]->Index]);
+        });
+        std::unordered_map<TypeId, std::size_t> counterMap;
+        bench::Run("std::unordered_map<TypeId>[Type::Id]", iterations, [&]()
+        {
+            bench::Consume(++counterMap[types[i++ % typeCount]->Id]);
+        });
+    }
+}
+
+namespace bench_array_ops
+{
+    struct Vec3
+    {
+        float X, Y, Z;
+    };
+
+    template<typename T>
+    void Run(const char* name)
+    {
+        constexpr std::size_t iterations = 100'000;
+        constexpr std::size_t count = 1000;
+
+        const Type& type = TypeOf<T>();
+        std::vector<std::byte> src(count * sizeof(T));
+        std::vector<std::byte> dst(count * sizeof(T));
+        type.ConstructN(src.data(), count);
+
+        std::cout << "    " << name << std::endl;
+        if (type.HaveCopyConstructN())
+        {
+            bench::Run("Type::CopyConstruct/Destruct per element", iterations, [&]()
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    type.CopyConstruct(src.data() + i * sizeof(T), dst.data() + i * sizeof(T));
+                for (std::size_t i = 0; i < count; ++i)
+                    type.Destruct(dst.data() + i * sizeof(T));
+            });
+            bench::Run("Type::CopyConstructN/DestructN", iterations, [&]()
+            {
+                type.CopyConstructN(src.data(), dst.data(), count);
+                type.DestructN(dst.data(), count);
+            });
+        }
+
+        // vector growth, elements go to a new buffer and back
+        bench::Run("Type::MoveConstruct/Destruct per element", iterations, [&]()
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                type.MoveConstruct(src.data() + i * sizeof(T), dst.data() + i * sizeof(T));
+                type.Destruct(src.data() + i * sizeof(T));
+            }
+            std::swap(src, dst);
+        });
+        bench::Run("Type::Relocate", iterations, [&]()
+        {
+            type.Relocate(src.data(), dst.data(), count);
+            std::swap(src, dst);
+        });
+        type.DestructN(src.data(), count);
+    }
+
+    void Run()
+    {
+        if (!bench::Group("1000 elements copy/destroy, relocate (array ops vs per element)"))
+            return;
+        Run<Vec3>("trivial (Vec3)");
+        Run<bench_type_functions::Foo>("non trivial (Foo)");
+        Run<std::unique_ptr<int>>("trivially relocatable (std::unique_ptr<int>)");
+    }
+}
+
+namespace bench_pool
+{
+    // alloc a batch then free it, like short lived nodes or messages
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000;
+        constexpr std::size_t batchSize = 1000;
+
+        const Type& type = TypeOf<bench_type_functions::Foo>();
+        std::vector<void*> objs(batchSize);
+
+        if (!bench::Group("1000 objects alloc/free (Type::NewPooled, Arena vs Type::New)"))
+            return;
+        std::cout << "    sizeof(Foo): " << sizeof(bench_type_functions::Foo) << ", block size: " << type.GetPoolStats().BlockSize << std::endl;
+        bench::Run("Type::New/Delete", iterations, [&]()
+        {
+            for (void*& obj : objs)
+                obj = type.New();
+            for (void* obj : objs)
+                type.Delete(obj);
+        });
+        bench::Run("Type::NewPooled/DeletePooled", iterations, [&]()
+        {
+            for (void*& obj : objs)
+                obj = type.NewPooled();
+            for (void* obj : objs)
+                type.DeletePooled(obj);
+        });
+        std::cout << "    slabs allocated: " << type.GetPoolStats().SlabsAllocated << std::endl;
+
+        // released all at once, like per request scratch objects
+        Arena arena;
+        bench::Run("Arena::Construct/Reset", iterations, [&]()
+        {
+            for (void*& obj : objs)
+                obj = arena.Construct(type);
+            arena.Reset();
+        });
+    }
+}
+
+namespace bench_enum
+{
+    ETI_ENUM
+    (
+        std::uint8_t, Color,
+            Black, White, Red, Green, Blue, Cyan, Magenta, Yellow,
+            Orange, Purple, Pink, Brown, Gray, Silver, Gold, Navy
+    )
+
+    ETI_ENUM
+    (
+        std::uint16_t, Code,
+            Ok = 0, Continue = 100, Created = 201, Accepted = 202, Moved = 301, Found = 302, BadRequest = 400, Unauthorized = 401,
+            Forbidden = 403, NotFound = 404, Conflict = 409, Teapot = 418, Error = 0x8001, Timeout = 0x8002, Busy = 0x9000, Fatal = 0xFFFF
+    )
+
+    ETI_ENUM_FLAGS
+    (
+        std::uint32_t, Access,
+            None = 0, Read = 1 << 0, Write = 1 << 1, Execute = 1 << 2, Delete = 1 << 3, List = 1 << 4, Admin = 1u << 31
+    )
+}
+ETI_ENUM_IMPL(bench_enum::Color)
+ETI_ENUM_IMPL(bench_enum::Code)
+ETI_ENUM_FLAGS_IMPL(bench_enum::Access)
+
+namespace bench_enum
+{
+    // previous implementation, scan stringified names on each call
+    std::string_view ScanEnumName(std::string_view names, size_t index)
+    {
+        size_t offset = 0;
+        for (; index > 0; --index)
+            offset = names.find(',', offset) + 1;
+        size_t first = names.find_first_not_of(' ', offset);
+        size_t last = names.find(',', first);
+        if (last == std::string_view::npos)
+            last = names.size();
+        return names.substr(first, last - first);
+    }
+
+    size_t ScanEnumValue(std::string_view names, size_t size, std::string_view name)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (ScanEnumName(names, i) == name)
+                return i;
+        }
+        return InvalidIndex;
+    }
+
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000'000;
+        const Type& type = TypeOf<Color>();
+
+        std::size_t i = 0;
+        bench::Group("enum names (entries tables vs names scan)");
+        bench::Run("Type::GetEnumValueName", iterations, [&]()
+        {
+            bench::Consume(type.GetEnumValueName(i++ % type.EnumSize).size());
+        });
+        bench::Run("names scan value to name", iterations, [&]()
+        {
+            bench::Consume(ScanEnumName(type.EnumNames, i++ % type.EnumSize).size());
+        });
+        bench::Run("Type::GetEnumValue", iterations, [&]()
+        {
+            bench::Consume(type.GetEnumValue(type.EnumEntries[i++ % type.EnumSize].Name));
+        });
+        bench::Run("names scan name to value", iterations, [&]()
+        {
+            bench::Consume(ScanEnumValue(type.EnumNames, type.EnumSize, type.EnumEntries[i++ % type.EnumSize].Name));
+        });
+
+        const Type& sparseType = TypeOf<Code>();
+        bench::Group("sparse enum names (perfect hash)");
+        bench::Run("Type::GetEnumValueName", iterations, [&]()
+        {
+            bench::Consume(sparseType.GetEnumValueName(sparseType.EnumEntries[i++ % sparseType.EnumSize].Value).size());
+        });
+        bench::Run("Type::GetEnumValue", iterations, [&]()
+        {
+            bench::Consume(sparseType.GetEnumValue(sparseType.EnumEntries[i++ % sparseType.EnumSize].Name));
+        });
+
+        const Type& flagsType = TypeOf<Access>();
+        std::size_t flags[] = { 0b1, 0b101, 0b11111, 0x80000003 };
+        char buffer[128];
+        bench::Group("flags enum (format into buffer, parse)");
+        bench::Run("Type::FormatEnumFlags", iterations, [&]()
+        {
+            bench::Consume(flagsType.FormatEnumFlags(flags[i++ % std::size(flags)], buffer));
+        });
+        std::string_view formatted[std::size(flags)];
+        std::deque<std::string> storage;
+        for (std::size_t f = 0; f < std::size(flags); ++f)
+            formatted[f] = storage.emplace_back(buffer, flagsType.FormatEnumFlags(flags[f], buffer));
+        bench::Run("Type::ParseEnumFlags", iterations, [&]()
+        {
+            std::size_t value = 0;
+            flagsType.ParseEnumFlags(formatted[i++ % std::size(flags)], value);
+            bench::Consume(value);
+        });
+    }
+}
+
+namespace bench_binary
+{
+    struct Particle
+    {
+        ETI_STRUCT_EXT(Particle,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(X), ETI_PROPERTY(Y), ETI_PROPERTY(Z),
+                ETI_PROPERTY(VX), ETI_PROPERTY(VY), ETI_PROPERTY(VZ),
+                ETI_PROPERTY(Life), ETI_PROPERTY(Id)
+            ),
+            ETI_METHODS())
+
+        float X = 0.0f, Y = 0.0f, Z = 0.0f;
+        float VX = 0.0f, VY = 0.0f, VZ = 0.0f;
+        float Life = 0.0f;
+        std::uint32_t Id = 0;
+
+        bool operator==(const Particle&) const = default;
+    };
+
+    struct Emitter
+    {
+        ETI_STRUCT_EXT(Emitter,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Name),
+                ETI_PROPERTY(Origin),
+                ETI_PROPERTY(Rate),
+                ETI_PROPERTY(Particles)
+            ),
+            ETI_METHODS())
+
+        std::string Name;
+        Particle Origin;
+        float Rate = 0.0f;
+        std::vector<Particle> Particles;
+    };
+
+    // baseline: walk reflected properties recursively, one write per pod field
+    void WriteFields(std::vector<std::byte>& buffer, const Type& type, const std::byte* obj)
+    {
+        for (const Property& property : type.Properties)
+        {
+            const Type& propertyType = *property.Variable.Declaration.Type;
+            const std::byte* member = obj + property.Offset;
+            if (propertyType.Kind == Kind::Pod)
+            {
+                size_t offset = buffer.size();
+                buffer.resize(offset + propertyType.Size);
+                std::memcpy(buffer.data() + offset, member, propertyType.Size);
+            }
+            else if (propertyType == TypeOf<std::string>())
+            {
+                const std::string& str = *reinterpret_cast<const std::string*>(member);
+                std::uint64_t size = str.size();
+                size_t offset = buffer.size();
+                buffer.resize(offset + sizeof(size) + str.size());
+                std::memcpy(buffer.data() + offset, &size, sizeof(size));
+                std::memcpy(buffer.data() + offset + sizeof(size), str.data(), str.size());
+            }
+            else if (propertyType == TypeOf<std::vector<Particle>>())
+            {
+                const std::vector<Particle>& vector = *reinterpret_cast<const std::vector<Particle>*>(member);
+                std::uint64_t size = vector.size();
+                size_t offset = buffer.size();
+                buffer.resize(offset + sizeof(size));
+                std::memcpy(buffer.data() + offset, &size, sizeof(size));
+                for (const Particle& particle : vector)
+                    WriteFields(buffer, TypeOf<Particle>(), reinterpret_cast<const std::byte*>(&particle));
+            }
+            else
+            {
+                WriteFields(buffer, propertyType, member);
+            }
+        }
+    }
+
+    void Run()
+    {
+        constexpr std::size_t iterations = 10'000;
+
+        Emitter emitter;
+        emitter.Name = "emitter";
+        emitter.Rate = 60.0f;
+        for (std::uint32_t i = 0; i < 1000; ++i)
+            emitter.Particles.push_back({ (float)i, 1.0f, 2.0f, 0.5f, 0.5f, 0.5f, 10.0f, i });
+
+        BinaryWriter writer;
+        if (bench::Group("binary write 1000 particles (plan vs fields walk)"))
+        {
+            bench::Run("BinaryWriter::Write", iterations, [&]()
+            {
+                writer.Clear();
+                writer.Write(emitter);
+                bench::Consume(writer.GetBuffer().size());
+            });
+            std::vector<std::byte> buffer;
+            bench::Run("properties walk", iterations, [&]()
+            {
+                buffer.clear();
+                WriteFields(buffer, TypeOf<Emitter>(), reinterpret_cast<const std::byte*>(&emitter));
+                bench::Consume(buffer.size());
+            });
+        }
+
+        bench::Group("binary read 1000 particles");
+        writer.Clear();
+        writer.Write(emitter);
+        Emitter result;
+        bench::Run("BinaryReader::Read", iterations, [&]()
+        {
+            BinaryReader reader(writer.GetBuffer());
+            bench::Consume(reader.Read(result));
+        });
+
+        // sum particles life: deserialize all vs open archive and read in place
+        bench::Group("archive 1000 particles (read in place vs deserialize)");
+        ArchiveWriter archiveWriter;
+        archiveWriter.Write(emitter);
+        std::span<const std::byte> archiveBuffer = archiveWriter.Finish();
+        bench::Run("BinaryReader::Read + sum", iterations, [&]()
+        {
+            BinaryReader reader(writer.GetBuffer());
+            reader.Read(result);
+            float life = 0.0f;
+            for (const Particle& particle : result.Particles)
+                life += particle.Life;
+            bench::Consume((std::size_t)life);
+        });
+        bench::Run("Archive::Open + sum", iterations, [&]()
+        {
+            Archive archive;
+            archive.Open(archiveBuffer);
+            float life = 0.0f;
+            for (const Particle& particle : archive.GetObject(0).GetMember("Particles").AsArray().As<Particle>())
+                life += particle.Life;
+            bench::Consume((std::size_t)life);
+        });
+    }
+}
+
+namespace bench_dynamic_array
+{
+    void Run()
+    {
+        using bench_binary::Particle;
+        using bench_type_functions::Foo;
+
+        if (bench::Group("1000 push back (DynamicArray vs std::vector)"))
+        {
+            constexpr std::size_t iterations = 10'000;
+            Foo foo;
+            bench::Run("std::vector<Foo>::push_back", iterations, [&]()
+            {
+                std::vector<Foo> foos;
+                for (std::size_t i = 0; i < 1000; ++i)
+                    foos.push_back(foo);
+                bench::Consume(foos.size());
+            });
+            bench::Run("DynamicArray(Foo)::PushBack", iterations, [&]()
+            {
+                DynamicArray foos(TypeOf<Foo>());
+                for (std::size_t i = 0; i < 1000; ++i)
+                    foos.PushBack(&foo);
+                bench::Consume(foos.GetSize());
+            });
+        }
+
+        if (bench::Group("sum a member of 1000000 particles (DynamicArray::GetMembers vs span vs Property::Get)"))
+        {
+            constexpr std::size_t iterations = 20;
+            constexpr std::size_t count = 1'000'000;
+            const Type& type = TypeOf<Particle>();
+            const Property& property = *type.GetProperty("Life");
+            DynamicArray particles(type);
+            particles.Resize(count);
+            std::span<Particle> span = particles.AsSpan<Particle>();
+            for (std::size_t i = 0; i < count; ++i)
+                span[i].Life = (float)(i % 100);
+
+            bench::Run("std::span<Particle>[i].Life", iterations, [&]()
+            {
+                float sum = 0.0f;
+                for (const Particle& particle : span)
+                    sum += particle.Life;
+                bench::Consume((std::size_t)sum);
+            });
+            bench::Run("MemberView<float>[i]", iterations, [&]()
+            {
+                MemberView<float> lifes = particles.GetMembers<float>(property);
+                float sum = 0.0f;
+                for (std::size_t i = 0; i < lifes.GetSize(); ++i)
+                    sum += lifes[i];
+                bench::Consume((std::size_t)sum);
+            });
+            bench::Run("Property::Get", iterations, [&]()
+            {
+                float sum = 0.0f;
+                for (Particle& particle : span)
+                {
+                    float life;
+                    property.Get(particle, life);
+                    sum += life;
+                }
+                bench::Consume((std::size_t)sum);
+            });
+        }
+    }
+}
+
+namespace bench_soa
+{
+    void Run()
+    {
+        using bench_binary::Particle;
+
+        if (!bench::Group("integrate X += VX of 1000000 particles (SoAVector columns vs std::vector)"))
+            return;
+
+        constexpr std::size_t iterations = 50;
+        constexpr std::size_t count = 1'000'000;
+        std::vector<Particle> particles(count);
+        for (std::size_t i = 0; i < count; ++i)
+            particles[i].VX = (float)(i % 10);
+        SoAVector<Particle> soa(particles);
+
+        bench::Run("std::vector<Particle>", iterations, [&]()
+        {
+            for (Particle& particle : particles)
+                particle.X += particle.VX;
+            bench::Consume((std::size_t)particles[count - 1].X);
+        });
+        const Type& type = TypeOf<Particle>();
+        TypeId xId = type.GetProperty("X")->PropertyId;
+        TypeId vxId = type.GetProperty("VX")->PropertyId;
+        bench::Run("SoAVector<Particle> columns", iterations, [&]()
+        {
+            std::span<float> x = soa.GetColumn<float>(xId);
+            std::span<const float> vx = soa.GetColumn<float>(vxId);
+            for (std::size_t i = 0; i < x.size(); ++i)
+                x[i] += vx[i];
+            bench::Consume((std::size_t)x[count - 1]);
+        });
+    }
+}
+
+namespace bench_gather
+{
+    void Run()
+    {
+        using bench_binary::Particle;
+
+        if (!bench::Group("gather/scatter Life of 1000000 particles (Property::Gather/Scatter vs Property::Get/Set)"))
+            return;
+
+        constexpr std::size_t iterations = 50;
+        constexpr std::size_t count = 1'000'000;
+        std::vector<Particle> particles(count);
+        for (std::size_t i = 0; i < count; ++i)
+            particles[i].Life = (float)(i % 100);
+        std::vector<float> lifes(count);
+        const Type& type = TypeOf<Particle>();
+        const Property& property = *type.GetProperty("Life");
+
+        bench::Run("typed loop", iterations, [&]()
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                lifes[i] = particles[i].Life;
+            bench::Consume((std::size_t)lifes[count - 1]);
+        });
+        bench::Run("Property::Get", iterations, [&]()
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                property.Get(particles[i], lifes[i]);
+            bench::Consume((std::size_t)lifes[count - 1]);
+        });
+        bench::Run("Property::Gather", iterations, [&]()
+        {
+            property.Gather(particles.data(), type.Size, count, lifes.data());
+            bench::Consume((std::size_t)lifes[count - 1]);
+        });
+        bench::Run("Property::Set", iterations, [&]()
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                property.Set(particles[i], lifes[i]);
+            bench::Consume((std::size_t)particles[count - 1].Life);
+        });
+        bench::Run("Property::Scatter", iterations, [&]()
+        {
+            property.Scatter(particles.data(), type.Size, count, lifes.data());
+            bench::Consume((std::size_t)particles[count - 1].Life);
+        });
+    }
+}
+
+namespace bench_json
+{
+    // flat numeric struct, json tokenizing throughput
+    struct Sample
+    {
+        ETI_STRUCT_EXT(Sample,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Id), ETI_PROPERTY(Time),
+                ETI_PROPERTY(X), ETI_PROPERTY(Y), ETI_PROPERTY(Z),
+                ETI_PROPERTY(Count), ETI_PROPERTY(Delta), ETI_PROPERTY(Flags)
+            ),
+            ETI_METHODS())
+
+        std::uint64_t Id = 0;
+        double Time = 0.0;
+        float X = 0.0f, Y = 0.0f, Z = 0.0f;
+        std::int32_t Count = 0;
+        std::int32_t Delta = 0;
+        std::uint32_t Flags = 0;
+
+        bool operator==(const Sample&) const = default;
+    };
+
+    struct Dataset
+    {
+        ETI_STRUCT_EXT(Dataset, ETI_PROPERTIES(ETI_PROPERTY(Samples)), ETI_METHODS())
+
+        std::vector<Sample> Samples;
+    };
+
+    // deterministic dataset, values of varied lengths
+    std::string Generate(std::size_t count)
+    {
+        Dataset dataset;
+        std::uint64_t seed = 0x9E3779B97F4A7C15ull;
+        auto random = [&seed]() { seed = seed * 6364136223846793005ull + 1442695040888963407ull; return (std::uint32_t)(seed >> 33); };
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Sample& sample = dataset.Samples.emplace_back();
+            sample.Id = i;
+            sample.Time = (double)i * 0.001;
+            sample.X = (float)(random() % 10000) / 100.0f;
+            sample.Y = (float)(random() % 100);
+            sample.Z = -(float)(random() % 1000) / 10.0f;
+            sample.Count = (std::int32_t)(random() % 100000);
+            sample.Delta = (std::int32_t)(random() % 200) - 100;
+            sample.Flags = random() % 16;
+        }
+        JsonWriter writer;
+        writer.Write(dataset);
+        return std::string(writer.GetBuffer());
+    }
+
+    void Run()
+    {
+        {
+            std::string json = Generate(100'000);
+            if (bench::Group("json throughput 100000 flat numeric structs (" + std::to_string(json.size() / 1024) + " KB)"))
+            {
+                bench::Run("StructuralScanner::Scan", 10, [&]()
+                {
+                    json::internal::StructuralScanner scanner;
+                    size_t positions[json::internal::ScanBlockSize];
+                    for (size_t offset = 0; offset + json::internal::ScanBlockSize <= json.size(); offset += json::internal::ScanBlockSize)
+                        bench::Consume(scanner.Scan(json.data() + offset, offset, positions));
+                }, json.size());
+                bench::Run("JsonReader::Next", 10, [&]()
+                {
+                    JsonReader reader(json);
+                    while (reader.Next() != JsonToken::End)
+                        bench::Consume(reader.GetText().size());
+                }, json.size());
+                Dataset dataset;
+                bench::Run("JsonReader::Read", 10, [&]()
+                {
+                    JsonReader reader(json);
+                    bench::Consume(reader.Read(dataset));
+                }, json.size());
+                JsonWriter writer;
+                bench::Run("JsonWriter::Write", 10, [&]()
+                {
+                    writer.Clear();
+                    writer.Write(dataset);
+                    bench::Consume(writer.GetBuffer().size());
+                }, json.size());
+            }
+        }
+
+        constexpr std::size_t iterations = 1'000;
+
+        bench_binary::Emitter emitter;
+        emitter.Name = "emitter";
+        emitter.Rate = 60.0f;
+        for (std::uint32_t i = 0; i < 1000; ++i)
+            emitter.Particles.push_back({ (float)i, 1.0f, 2.0f, 0.5f, 0.5f, 0.5f, 10.0f, i });
+
+        if (!bench::Group("json 1000 particles (write, tokens only, read)"))
+            return;
+
+        JsonWriter writer;
+        bench::Run("JsonWriter::Write", iterations, [&]()
+        {
+            writer.Clear();
+            writer.Write(emitter);
+            bench::Consume(writer.GetBuffer().size());
+        });
+        std::string json(writer.GetBuffer());
+        bench::Run("JsonReader::Next", iterations, [&]()
+        {
+            JsonReader reader(json);
+            while (reader.Next() != JsonToken::End)
+                bench::Consume(reader.GetText().size());
+        });
+        bench_binary::Emitter result;
+        bench::Run("JsonReader::Read", iterations, [&]()
+        {
+            JsonReader reader(json);
+            bench::Consume(reader.Read(result));
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string jsonPath;
+    std::string generatePath;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--filter")
+            bench::Filter = argv[i + 1];
+        else if (arg == "--json")
+            jsonPath = argv[i + 1];
+        else if (arg == "--generate")
+            generatePath = argv[i + 1];
+    }
+
+    // write json throughput dataset (1M flat numeric structs) to a file and exit
+    if (!generatePath.empty())
+    {
+        std::ofstream file(generatePath, std::ios::binary);
+        file << bench_json::Generate(1'000'000);
+        return file ? 0 : 1;
+    }
+
+    bench_core::Run();
+    bench_type_functions::Run();
+    bench_isa::Run();
+    bench_repository::Run();
+    bench_type_index::Run();
+    bench_array_ops::Run();
+    bench_pool::Run();
+    bench_enum::Run();
+    bench_binary::Run();
+    bench_dynamic_array::Run();
+    bench_soa::Run();
+    bench_gather::Run();
+    bench_json::Run();
+
+    if (!jsonPath.empty() && !bench::WriteJson(jsonPath))
+    {
+        std::cerr << "can't write " << jsonPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -4,6 +4,8 @@
 #define ETI_SLIM_MODE 0 // todo: set to 1 once implemented
 #include <eti/eti.h>
 
+ETI_REPOSITORY_IMPL()
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace minimal_test_01
 {
@@ -22,14 +22,59 @@
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "doctest.h"
 
 #include <eti/eti.h>
+#include <eti/eti_archive.h>
+#include <eti/eti_binary.h>
+#include <eti/eti_json.h>
+
+ETI_REPOSITORY_IMPL()
 
 using namespace eti;
 
+////////////////////////////////////////////////////////////////////////////////
+// count global allocations, used to validate allocation free path
+namespace allocations
+{
+    std::atomic<std::size_t> Count = 0;
+
+    std::size_t GetCount() { return Count.load(std::memory_order_relaxed); }
+}
+
+void* operator new(std::size_t size)
+{
+    allocations::Count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace test_01
 {
@@ -40,7 +85,7 @@ namespace test_01
         std::string fooTypeName(GetTypeName<Foo>());
         REQUIRE(fooTypeName == "test_01::Foo");
 
-        TypeId fooNameHash = ETI_HASH_FUNCTION(GetTypeName<Foo>());
+        TypeId fooNameHash = utils::GetStringHash(GetTypeName<Foo>());
 
         TypeId fooTypeId = GetTypeId<Foo>();
         REQUIRE(fooTypeId == fooNameHash);
@@ -1554,4 +1599,2133 @@ namespace test_27
         REQUIRE(ret == 3);
 
     }
-}
\ No newline at end of file
+}
+
+namespace test_28
+{
+    // method call should never allocate
+    struct Foo
+    {
+        ETI_STRUCT_EXT
+        (Foo,
+            ETI_PROPERTIES(),
+            ETI_METHODS
+            (
+                ETI_METHOD(Set),
+                ETI_METHOD(Get),
+                ETI_METHOD(Add),
+                ETI_METHOD_LAMBDA(Mul, [](Foo& foo, int x) { return foo.Value * x; })
+            )
+        )
+
+        void Set(int value, float scale) { Value = (int)((float)value * scale); }
+        int Get() const { return Value; }
+        static int Add(int n0, int n1) { return n0 + n1; }
+
+        int Value = 0;
+    };
+
+    TEST_CASE("test_28")
+    {
+        const Type& type = TypeOf<Foo>();
+        const Method* set = type.GetMethod("Set");
+        const Method* get = type.GetMethod("Get");
+        const Method* add = type.GetMethod("Add");
+        const Method* mul = type.GetMethod("Mul");
+        const Method* getAt = TypeOf<std::vector<int>>().GetMethod("GetAt");
+
+        Foo foo;
+        std::vector<int> vector = { 1, 2, 3 };
+        int ret = 0;
+        int* retPtr = nullptr;
+        float scale = 1.0f;
+
+        // first calls initialize types
+        set->CallMethod(foo, NoReturn, 1, scale);
+        get->CallMethod(foo, &ret);
+        add->CallStaticMethod(&ret, 1, 2);
+        mul->CallMethod(foo, &ret, 2);
+        getAt->CallMethod(vector, &retPtr, (size_t)1);
+
+        std::size_t count = allocations::GetCount();
+        for (int i = 0; i < 1000; ++i)
+        {
+            set->CallMethod(foo, NoReturn, i, scale);
+            get->CallMethod(foo, &ret);
+            REQUIRE(ret == i);
+
+            add->CallStaticMethod(&ret, i, 1);
+            REQUIRE(ret == i + 1);
+
+            mul->CallMethod(foo, &ret, 2);
+            REQUIRE(ret == i * 2);
+
+            getAt->CallMethod(vector, &retPtr, (size_t)2);
+            REQUIRE(*retPtr == 3);
+
+            void* args[] = { &i, &scale };
+            set->UnSafeCall(&foo, NoReturn, args);
+            REQUIRE(foo.Value == i);
+        }
+        REQUIRE(allocations::GetCount() - count == 0);
+    }
+}
+
+namespace test_29
+{
+    // flattened members lookup (own and inherited)
+    class Middle;
+
+    class Base
+    {
+        ETI_BASE_EXT
+        (
+            Base,
+            ETI_PROPERTIES(ETI_PROPERTY(A), ETI_PROPERTY(Child)),
+            ETI_METHODS(ETI_METHOD(GetName), ETI_METHOD(GetA))
+        )
+
+    public:
+        virtual ~Base() {}
+        virtual std::string_view GetName() { return "Base"; }
+        int GetA() { return A; }
+
+        int A = 1;
+        Middle* Child = nullptr; // cyclic: Middle is initialized while Base is initializing
+    };
+
+    class Middle : public Base
+    {
+        ETI_CLASS_EXT(Middle, Base, ETI_PROPERTIES(ETI_PROPERTY(B)), ETI_METHODS(ETI_METHOD(GetName)))
+
+    public:
+        std::string_view GetName() override { return "Middle"; }
+
+        int B = 2;
+    };
+
+    class Leaf : public Middle
+    {
+        ETI_CLASS_EXT(Leaf, Middle, ETI_PROPERTIES(ETI_PROPERTY(C)), ETI_METHODS(ETI_METHOD(GetC)))
+
+    public:
+        int GetC() { return C; }
+
+        int C = 3;
+    };
+
+    TEST_CASE("test_29")
+    {
+        const Type& base = TypeOf<Base>();
+        const Type& middle = TypeOf<Middle>();
+        const Type& leaf = TypeOf<Leaf>();
+
+        // inherited properties
+        REQUIRE(base.GetProperty("A") != nullptr);
+        REQUIRE(middle.GetProperty("A") == base.GetProperty("A"));
+        REQUIRE(leaf.GetProperty("A") == base.GetProperty("A"));
+        REQUIRE(leaf.GetProperty("Child") == base.GetProperty("Child"));
+        REQUIRE(leaf.GetProperty("B") == middle.GetProperty("B"));
+        REQUIRE(leaf.GetProperty("C") != nullptr);
+        REQUIRE(base.GetProperty("B") == nullptr);
+        REQUIRE(middle.GetProperty("C") == nullptr);
+        REQUIRE(leaf.GetProperty("D") == nullptr);
+
+        // by id
+        REQUIRE(leaf.GetProperty(utils::GetStringHash("A")) == base.GetProperty("A"));
+        REQUIRE(leaf.GetProperty(utils::GetStringHash("C")) == leaf.GetProperty("C"));
+        REQUIRE(leaf.GetProperty(utils::GetStringHash("D")) == nullptr);
+
+        // own method hide inherited one
+        REQUIRE(base.GetMethod("GetName")->Parent == &base);
+        REQUIRE(middle.GetMethod("GetName")->Parent == &middle);
+        REQUIRE(leaf.GetMethod("GetName")->Parent == &middle);
+        REQUIRE(leaf.GetMethod("GetA")->Parent == &base);
+        REQUIRE(leaf.GetMethod(utils::GetStringHash("GetC"))->Parent == &leaf);
+        REQUIRE(base.GetMethod("GetC") == nullptr);
+
+        // flattened tables
+        auto count = [](const auto& table) { return std::ranges::count_if(table, [](const auto& slot) { return slot.Member != nullptr; }); };
+        REQUIRE(count(leaf.PropertyTable) == 4);
+        REQUIRE(count(leaf.MethodTable) == 3);
+
+        Leaf l;
+        int c = 0;
+        leaf.GetMethod("GetC")->CallMethod(l, &c);
+        REQUIRE(c == 3);
+        std::string_view name;
+        leaf.GetMethod("GetName")->CallMethod(l, &name);
+        REQUIRE(name == "Middle");
+    }
+}
+
+namespace test_30
+{
+    // ancestors display
+    class A
+    {
+        ETI_BASE(A)
+    public:
+        virtual ~A() {}
+    };
+
+    class B : public A
+    {
+        ETI_CLASS(B, A)
+    };
+
+    class C : public B
+    {
+        ETI_CLASS(C, B)
+    };
+
+    class D : public C
+    {
+        ETI_CLASS(D, C)
+    };
+
+    class E : public B
+    {
+        ETI_CLASS(E, B)
+    };
+
+    TEST_CASE("test_30")
+    {
+        const Type& d = TypeOf<D>();
+        REQUIRE(TypeOf<A>().Depth == 0);
+        REQUIRE(TypeOf<B>().Depth == 1);
+        REQUIRE(TypeOf<E>().Depth == 2);
+        REQUIRE(d.Depth == 3);
+        REQUIRE(d.Ancestors.size() == 4);
+        REQUIRE(d.Ancestors[0] == TypeOf<A>().Id);
+        REQUIRE(d.Ancestors[1] == TypeOf<B>().Id);
+        REQUIRE(d.Ancestors[2] == TypeOf<C>().Id);
+        REQUIRE(d.Ancestors[3] == d.Id);
+
+        REQUIRE(IsATyped<D, A>());
+        REQUIRE(IsATyped<D, B>());
+        REQUIRE(IsATyped<D, D>());
+        REQUIRE(!IsATyped<D, E>());
+        REQUIRE(!IsATyped<E, C>());
+        REQUIRE(!IsATyped<A, B>());
+        REQUIRE(!IsATyped<D, Object>());
+
+        D dInstance;
+        E eInstance;
+        A* a = &dInstance;
+        REQUIRE(Cast<C>(a) == &dInstance);
+        REQUIRE(Cast<E>(a) == nullptr);
+        a = &eInstance;
+        REQUIRE(Cast<B>(a) == &eInstance);
+        REQUIRE(Cast<C>(a) == nullptr);
+
+        // pod and enum
+        REQUIRE(TypeOf<int>().Depth == 0);
+        REQUIRE(IsA(TypeOf<int>(), TypeOf<int>()));
+        REQUIRE(!IsA(TypeOf<int>(), TypeOf<float>()));
+    }
+}
+
+namespace test_31
+{
+    // concurrent first time type initialization
+    class Base
+    {
+        ETI_BASE(Base)
+    public:
+        virtual ~Base() {}
+    };
+
+    template<int N>
+    class Leaf : public Base
+    {
+        ETI_CLASS_EXT(Leaf, Base, ETI_PROPERTIES(ETI_PROPERTY(Value)), ETI_METHODS(ETI_METHOD(GetValue)))
+    public:
+        int GetValue() const { return Value; }
+        int Value = N;
+    };
+
+    constexpr int LeafCount = 256;
+
+    template<int I>
+    int GetValue(const Property& property, Leaf<I>& leaf)
+    {
+        int value = 0;
+        property.Get(leaf, value);
+        return value;
+    }
+
+    template<int... N>
+    bool CheckTypes(std::integer_sequence<int, N...>)
+    {
+        auto check = []<int I>(Leaf<I>*)
+        {
+            const Type& type = TypeOf<Leaf<I>>();
+            Leaf<I> leaf;
+            const Property* property = type.GetProperty("Value");
+            return IsA(type, TypeOf<Base>()) && property != nullptr && GetValue(*property, leaf) == I && type.GetMethod("GetValue") != nullptr;
+        };
+        return (check((Leaf<N>*)nullptr) && ...);
+    }
+
+    TEST_CASE("test_31")
+    {
+        size_t threadCount = std::max(16u, std::thread::hardware_concurrency() * 2);
+        std::atomic<bool> start = false;
+        std::atomic<size_t> failures = 0;
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                while (!start.load())
+                    std::this_thread::yield();
+                if (!CheckTypes(std::make_integer_sequence<int, LeafCount>()))
+                    ++failures;
+            });
+        }
+
+        start = true;
+        for (std::thread& thread : threads)
+            thread.join();
+
+        REQUIRE(failures == 0);
+        REQUIRE(TypeOf<Leaf<0>>().Id != TypeOf<Leaf<1>>().Id);
+    }
+}
+
+namespace test_32
+{
+    // repository
+    struct Point
+    {
+        ETI_STRUCT(Point)
+        int X = 0;
+        int Y = 0;
+    };
+
+    TEST_CASE("test_32")
+    {
+        Repository& repository = Repository::Instance();
+
+        const Type& type = TypeOf<Point>();
+        REQUIRE(repository.GetType(type.Id) == &type);
+        REQUIRE(repository.GetType(type.Name) == &type);
+        REQUIRE(repository.GetType(TypeOf<int>().Id) == &TypeOf<int>());
+        REQUIRE(repository.GetType(GetTypeId<std::string>()) == &TypeOf<std::string>());
+        REQUIRE(repository.GetType("test_32::Unknown") == nullptr);
+        REQUIRE(repository.GetType(utils::GetStringHash("test_32::Unknown")) == nullptr);
+
+        // more types than initial table capacity
+        REQUIRE(test_31::CheckTypes(std::make_integer_sequence<int, test_31::LeafCount>()));
+        REQUIRE(repository.GetTypeCount() > 256);
+        REQUIRE(repository.GetType(TypeOf<test_31::Leaf<0>>().Id) == &TypeOf<test_31::Leaf<0>>());
+        REQUIRE(repository.GetType(TypeOf<test_31::Leaf<255>>().Name) == &TypeOf<test_31::Leaf<255>>());
+    }
+}
+
+namespace test_33
+{
+    // enum names
+    ETI_ENUM
+    (
+        std::uint8_t, Day,
+            Monday,
+            Tuesday,
+            Wednesday,
+            Thursday,
+            Friday,
+            Saturday,
+            Sunday
+    )
+
+    // parsed at compile time
+    static_assert(internal::MakeEnumEntries<std::uint8_t, 7>(DayNames)[0].Name == "Monday");
+    static_assert(internal::MakeEnumEntries<std::uint8_t, 7>(DayNames)[6].Name == "Sunday");
+    static_assert(internal::MakeEnumEntries<std::uint8_t, 7>(DayNames)[6].Value == 6);
+}
+ETI_ENUM_IMPL(test_33::Day)
+
+namespace test_33
+{
+    TEST_CASE("test_33")
+    {
+        const Type& type = TypeOf<Day>();
+        REQUIRE(type.Kind == Kind::Enum);
+        REQUIRE(type.EnumSize == 7);
+        REQUIRE(type.EnumEntries.size() == 7);
+        REQUIRE(type.GetEnumValueName((size_t)Day::Monday) == "Monday");
+        REQUIRE(type.GetEnumValueName((size_t)Day::Thursday) == "Thursday");
+        REQUIRE(type.GetEnumValueName((size_t)Day::Sunday) == "Sunday");
+        REQUIRE(type.GetEnumValueName(7).empty());
+        REQUIRE(type.GetEnumValue("Monday") == (size_t)Day::Monday);
+        REQUIRE(type.GetEnumValue("Saturday") == (size_t)Day::Saturday);
+        REQUIRE(type.GetEnumValue("Sunday") == (size_t)Day::Sunday);
+        REQUIRE(type.GetEnumValue("Sun") == InvalidIndex);
+        REQUIRE(type.GetEnumValue("") == InvalidIndex);
+        for (const EnumEntry& entry : type.EnumEntries)
+            REQUIRE(type.GetEnumValue(type.GetEnumValueName(entry.Value)) == entry.Value);
+    }
+}
+
+namespace test_34
+{
+    // explicit and sparse enum values
+    ETI_ENUM
+    (
+        std::uint16_t, Code,
+            Ok,
+            Warning = 0x10,
+            Info,
+            Error = 0x8001,
+            Fatal = Error + 1,
+            Mask = 0b1111'0000 | (1 << 12),
+            Octal = 017u,
+            Last = 60'000,
+    )
+
+    ETI_ENUM
+    (
+        std::int8_t, Sign,
+            Negative = -1,
+            Zero,
+            Comma = ',',
+            Quote = '\'',
+            Alias = Zero
+    )
+
+    // values wider than underlying type
+    ETI_ENUM
+    (
+        std::uint32_t, Wide,
+            B = 0,
+            C = ~0u,
+            D = 0xFFFFFFFF
+    )
+
+    static_assert(internal::GetEnumEntryCount(CodeNames) == 8);
+    static_assert(internal::MakeEnumEntries<std::uint16_t, 8>(CodeNames)[2].Value == (size_t)Code::Info);
+    static_assert(internal::MakeEnumEntries<std::uint16_t, 8>(CodeNames)[4].Value == (size_t)Code::Fatal);
+    static_assert(internal::MakeEnumEntries<std::uint16_t, 8>(CodeNames)[5].Value == (size_t)Code::Mask);
+    static_assert(internal::MakeEnumEntries<std::uint16_t, 8>(CodeNames)[6].Value == (size_t)Code::Octal);
+    static_assert(internal::MakeEnumEntries<std::uint16_t, 8>(CodeNames)[7].Value == (size_t)Code::Last);
+    static_assert(internal::GetEnumEntryCount(SignNames) == 5);
+    static_assert(internal::MakeEnumEntries<std::int8_t, 5>(SignNames)[3].Name == "Quote");
+    static_assert(internal::MakeEnumEntries<std::int8_t, 5>(SignNames)[3].Value == (size_t)Sign::Quote);
+    static_assert(internal::MakeEnumEntries<std::uint32_t, 3>(WideNames)[1].Value == (size_t)Wide::C);
+}
+ETI_ENUM_IMPL(test_34::Code)
+ETI_ENUM_IMPL(test_34::Sign)
+ETI_ENUM_IMPL(test_34::Wide)
+
+namespace test_34
+{
+    TEST_CASE("test_34")
+    {
+        // sparse, perfect hash
+        const Type& code = TypeOf<Code>();
+        REQUIRE(code.EnumSize == 8);
+        REQUIRE(code.EnumValueTable.Multiplier != 0);
+        for (const EnumEntry& entry : code.EnumEntries)
+        {
+            REQUIRE(code.GetEnumValueName(entry.Value) == entry.Name);
+            REQUIRE(code.GetEnumValue(entry.Name) == entry.Value);
+        }
+        REQUIRE(code.GetEnumValueName((size_t)Code::Error) == "Error");
+        REQUIRE(code.GetEnumValue("Fatal") == (size_t)Code::Fatal);
+        REQUIRE(code.GetEnumValueName(0x8003).empty());
+        REQUIRE(code.GetEnumValueName(1).empty());
+
+        // negative values, dense
+        const Type& sign = TypeOf<Sign>();
+        REQUIRE(sign.EnumSize == 5);
+        REQUIRE(sign.EnumValueTable.Multiplier == 0);
+        REQUIRE(sign.GetEnumValueName((size_t)Sign::Negative) == "Negative");
+        REQUIRE(sign.GetEnumValueName((size_t)Sign::Comma) == "Comma");
+        REQUIRE(sign.GetEnumValueName((size_t)Sign::Quote) == "Quote");
+        REQUIRE(sign.GetEnumValue("Negative") == (size_t)Sign::Negative);
+        REQUIRE(sign.GetEnumValue("Alias") == (size_t)Sign::Zero);
+        // first declared name for aliases
+        REQUIRE(sign.GetEnumValueName((size_t)Sign::Alias) == "Zero");
+        REQUIRE(sign.GetEnumValueName(2).empty());
+
+        // ~0u is 0xFFFFFFFF, alias of D
+        const Type& wide = TypeOf<Wide>();
+        REQUIRE(wide.GetEnumValue("C") == (size_t)Wide::C);
+        REQUIRE(wide.GetEnumValue("D") == (size_t)Wide::C);
+        REQUIRE(wide.GetEnumValueName((size_t)Wide::C) == "C");
+        REQUIRE(wide.GetEnumValueName((size_t)Wide::D) == "C");
+        REQUIRE(wide.GetEnumValueName((size_t)Wide::B) == "B");
+    }
+}
+
+namespace test_35
+{
+    // flags enum
+    ETI_ENUM_FLAGS
+    (
+        std::uint8_t, Access,
+            None = 0,
+            Read = 1 << 0,
+            Write = 1 << 1,
+            Execute = 1 << 2,
+            ReadWrite = Read | Write,
+            Admin = 1 << 7
+    )
+
+    ETI_ENUM_FLAGS
+    (
+        std::int8_t, Signed,
+            A = 1 << 0,
+            Sign = -128
+    )
+
+    // all bits entry of underlying type
+    ETI_ENUM_FLAGS
+    (
+        std::uint32_t, Mask,
+            None = 0,
+            X = 1,
+            Y = 2,
+            All = ~0u
+    )
+}
+ETI_ENUM_FLAGS_IMPL(test_35::Access)
+ETI_ENUM_FLAGS_IMPL(test_35::Signed)
+ETI_ENUM_FLAGS_IMPL(test_35::Mask)
+
+namespace test_35
+{
+    TEST_CASE("test_35")
+    {
+        const Type& type = TypeOf<Access>();
+        REQUIRE(type.EnumFlags);
+        REQUIRE(!TypeOf<test_33::Day>().EnumFlags);
+        REQUIRE(type.EnumBits.size() == 8);
+        REQUIRE(type.EnumBits[0]->Name == "Read");
+        REQUIRE(type.EnumBits[2]->Name == "Execute");
+        REQUIRE(type.EnumBits[3] == nullptr);
+        REQUIRE(type.EnumBits[7]->Name == "Admin");
+
+        char buffer[64];
+        auto format = [&](size_t value)
+        {
+            size_t size = type.FormatEnumFlags(value, buffer);
+            return size == InvalidIndex ? std::string_view("<error>") : std::string_view(buffer, size);
+        };
+        REQUIRE(format(0) == "None");
+        REQUIRE(format((size_t)Access::Write) == "Write");
+        REQUIRE(format((size_t)Access::ReadWrite) == "ReadWrite");
+        REQUIRE(format(0b101) == "Read|Execute");
+        REQUIRE(format(0b10000111) == "Read|Write|Execute|Admin");
+        REQUIRE(format(0b1000) == "<error>");
+
+        // buffer too small
+        char small[8];
+        REQUIRE(type.FormatEnumFlags(0b101, small) == InvalidIndex);
+        REQUIRE(type.FormatEnumFlags(0b100, small) == 7);
+
+        size_t value = 0;
+        REQUIRE(type.ParseEnumFlags("Read|Execute", value));
+        REQUIRE(value == 0b101);
+        REQUIRE(type.ParseEnumFlags(" ReadWrite | Admin ", value));
+        REQUIRE(value == 0b10000011);
+        REQUIRE(type.ParseEnumFlags("None", value));
+        REQUIRE(value == 0);
+        REQUIRE(type.ParseEnumFlags("", value));
+        REQUIRE(value == 0);
+        REQUIRE(!type.ParseEnumFlags("Read|Unknown", value));
+        REQUIRE(!type.ParseEnumFlags("Read|", value));
+
+        for (size_t bits = 0; bits < 256; ++bits)
+        {
+            if (type.FormatEnumFlags(bits, buffer) == InvalidIndex)
+                continue;
+            REQUIRE(type.ParseEnumFlags(format(bits), value));
+            REQUIRE(value == bits);
+        }
+
+        // signed underlying type
+        const Type& signedType = TypeOf<Signed>();
+        REQUIRE(signedType.EnumBits[7]->Name == "Sign");
+        size_t signedValue = (size_t)(std::int8_t)((std::int8_t)Signed::A | (std::int8_t)Signed::Sign);
+        size_t size = signedType.FormatEnumFlags(signedValue, buffer);
+        REQUIRE(std::string_view(buffer, size) == "A|Sign");
+        REQUIRE(signedType.ParseEnumFlags("A|Sign", value));
+        REQUIRE(value == signedValue);
+
+        // all bits
+        const Type& maskType = TypeOf<Mask>();
+        REQUIRE(maskType.EnumBits.size() == 32);
+        REQUIRE(maskType.EnumBits[31] == nullptr);
+        size = maskType.FormatEnumFlags((size_t)Mask::All, buffer);
+        REQUIRE(size != InvalidIndex);
+        REQUIRE(std::string_view(buffer, size) == "All");
+        size = maskType.FormatEnumFlags((size_t)Mask::X | (size_t)Mask::Y, buffer);
+        REQUIRE(std::string_view(buffer, size) == "X|Y");
+        REQUIRE(maskType.ParseEnumFlags("All", value));
+        REQUIRE(value == (size_t)Mask::All);
+        REQUIRE(maskType.ParseEnumFlags("X|All", value));
+        REQUIRE(value == (size_t)Mask::All);
+    }
+}
+
+namespace test_36
+{
+    ETI_ENUM
+    (
+        std::uint8_t, Shape,
+            Circle,
+            Square
+    )
+
+    struct Point
+    {
+        ETI_STRUCT_EXT(Point,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(X),
+                ETI_PROPERTY(Y)
+            ),
+            ETI_METHODS())
+
+        float X = 0.0f;
+        float Y = 0.0f;
+
+        // std::vector reflection require ==
+        bool operator==(const Point&) const = default;
+    };
+
+    struct Item
+    {
+        ETI_STRUCT_EXT(Item,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Id),
+                ETI_PROPERTY(Name),
+                ETI_PROPERTY(Position)
+            ),
+            ETI_METHODS())
+
+        int Id = 0;
+        std::string Name;
+        Point Position;
+
+        bool operator==(const Item&) const = default;
+    };
+
+    class Entity
+    {
+        ETI_BASE_EXT(Entity, ETI_PROPERTIES
+        (
+            ETI_PROPERTY(Id),
+            ETI_PROPERTY(Flags)
+        ),
+        ETI_METHODS())
+
+    public:
+        virtual ~Entity() {}
+
+        std::uint32_t Id = 0;
+        std::uint32_t Flags = 0;
+    };
+
+    class Scene : public Entity
+    {
+        ETI_CLASS_EXT(Scene, Entity, ETI_PROPERTIES
+        (
+            ETI_PROPERTY(Origin),
+            ETI_PROPERTY(Kind),
+            ETI_PROPERTY(Title),
+            ETI_PROPERTY(Parent),
+            ETI_PROPERTY(Points),
+            ETI_PROPERTY(Items),
+            ETI_PROPERTY(Lookup)
+        ),
+        ETI_METHODS())
+
+    public:
+        Point Origin;
+        Shape Kind = Shape::Circle;
+        std::string Title;
+        Scene* Parent = nullptr;
+        std::vector<Point> Points;
+        std::vector<Item> Items;
+        std::map<std::string, int> Lookup;
+    };
+}
+ETI_ENUM_IMPL(test_36::Shape)
+
+namespace test_36
+{
+    TEST_CASE("test_36")
+    {
+        // adjacent pods merged: Entity::Id, Entity::Flags, Origin.X, Origin.Y, Kind
+        const binary::Plan& plan = binary::GetPlan(TypeOf<Scene>());
+        REQUIRE(plan.IsTrivial == false);
+        REQUIRE(plan.Steps.size() == 5);
+        REQUIRE(plan.Steps[0].Kind == binary::StepKind::Copy);
+        REQUIRE(plan.Steps[0].Offset == offsetof(Scene, Id));
+        REQUIRE(plan.Steps[0].Size == offsetof(Scene, Kind) + sizeof(Shape) - offsetof(Scene, Id));
+        REQUIRE(plan.Steps[1].Kind == binary::StepKind::String);
+        REQUIRE(plan.Steps[2].Kind == binary::StepKind::Vector);
+        REQUIRE(plan.Steps[2].Element->IsTrivial);
+        REQUIRE(plan.Steps[3].Kind == binary::StepKind::Vector);
+        REQUIRE(plan.Steps[3].Element->IsTrivial == false);
+        REQUIRE(plan.Steps[4].Kind == binary::StepKind::Map);
+        REQUIRE(&binary::GetPlan(TypeOf<Scene>()) == &plan);
+
+        Scene scene;
+        scene.Id = 7;
+        scene.Flags = 0xF0F0;
+        scene.Origin = { 1.5f, -2.5f };
+        scene.Kind = Shape::Square;
+        scene.Title = "scene";
+        scene.Parent = &scene;
+        scene.Points = { { 1.0f, 2.0f }, { 3.0f, 4.0f }, { 5.0f, 6.0f } };
+        scene.Items = { { 1, "first", { 1.0f, 1.0f } }, { 2, std::string(64, 'x'), { 2.0f, 2.0f } } };
+        scene.Lookup = { { "a", 1 }, { "b", 2 }, { "c", 3 } };
+
+        BinaryWriter writer;
+        writer.Write(scene);
+
+        Scene result;
+        result.Lookup = { { "z", 26 } };
+        BinaryReader reader(writer.GetBuffer());
+        REQUIRE(reader.Read(result));
+        REQUIRE(reader.IsEnd());
+        REQUIRE(result.Id == 7);
+        REQUIRE(result.Flags == 0xF0F0);
+        REQUIRE(result.Origin.X == 1.5f);
+        REQUIRE(result.Origin.Y == -2.5f);
+        REQUIRE(result.Kind == Shape::Square);
+        REQUIRE(result.Title == "scene");
+        // pointers are not serialized
+        REQUIRE(result.Parent == nullptr);
+        REQUIRE(result.Points.size() == 3);
+        REQUIRE(result.Points[2].X == 5.0f);
+        REQUIRE(result.Points[2].Y == 6.0f);
+        REQUIRE(result.Items.size() == 2);
+        REQUIRE(result.Items[0].Name == "first");
+        REQUIRE(result.Items[1].Id == 2);
+        REQUIRE(result.Items[1].Name == std::string(64, 'x'));
+        REQUIRE(result.Items[1].Position.Y == 2.0f);
+        REQUIRE(result.Lookup == scene.Lookup);
+
+        // truncated data fail at any size
+        std::span<const std::byte> buffer = writer.GetBuffer();
+        for (size_t size = 0; size < buffer.size(); ++size)
+        {
+            Scene truncated;
+            BinaryReader truncatedReader(buffer.first(size));
+            REQUIRE(truncatedReader.Read(truncated) == false);
+        }
+
+        // corrupted element count fail without allocation
+        std::vector<std::string> names = { "a", "bb", "ccc" };
+        BinaryWriter namesWriter;
+        namesWriter.Write(names);
+        std::vector<std::byte> corrupted(namesWriter.GetBuffer().begin(), namesWriter.GetBuffer().end());
+        size_t countOffset = corrupted.size() - sizeof(std::uint64_t);
+        for (const std::string& name : names)
+            countOffset -= sizeof(std::uint64_t) + name.size();
+        std::uint64_t count = 0;
+        std::memcpy(&count, corrupted.data() + countOffset, sizeof(count));
+        REQUIRE(count == names.size());
+        count = 1ull << 44;
+        std::memcpy(corrupted.data() + countOffset, &count, sizeof(count));
+        std::vector<std::string> corruptedNames;
+        BinaryReader corruptedReader(corrupted);
+        REQUIRE(corruptedReader.Read(corruptedNames) == false);
+
+        // corrupted map key (repeated) fail
+        std::map<std::string, int> lookup = { { "a", 1 }, { "b", 2 } };
+        BinaryWriter lookupWriter;
+        lookupWriter.Write(lookup);
+        std::vector<std::byte> repeated(lookupWriter.GetBuffer().begin(), lookupWriter.GetBuffer().end());
+        auto keyB = std::find(repeated.rbegin(), repeated.rend(), std::byte{ 'b' });
+        REQUIRE(keyB != repeated.rend());
+        *keyB = std::byte{ 'a' };
+        std::map<std::string, int> repeatedLookup;
+        BinaryReader repeatedReader(repeated);
+        REQUIRE(repeatedReader.Read(repeatedLookup) == false);
+        BinaryReader lookupReader(lookupWriter.GetBuffer());
+        REQUIRE(lookupReader.Read(repeatedLookup));
+        REQUIRE(repeatedLookup == lookup);
+    }
+}
+
+namespace test_37
+{
+    ETI_ENUM
+    (
+        std::int8_t, Level,
+            Low = -1,
+            Normal,
+            High
+    )
+
+    ETI_ENUM_FLAGS
+    (
+        std::uint8_t, Channel,
+            None = 0,
+            Red = 1 << 0,
+            Green = 1 << 1,
+            Blue = 1 << 2
+    )
+
+    struct Vec
+    {
+        ETI_STRUCT_EXT(Vec,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(X),
+                ETI_PROPERTY(Y)
+            ),
+            ETI_METHODS())
+
+        double X = 0.0;
+        double Y = 0.0;
+
+        bool operator==(const Vec&) const = default;
+    };
+
+    class Node
+    {
+        ETI_BASE_EXT(Node, ETI_PROPERTIES
+        (
+            ETI_PROPERTY(Id)
+        ),
+        ETI_METHODS())
+
+    public:
+        virtual ~Node() {}
+
+        std::uint64_t Id = 0;
+    };
+
+    class Config : public Node
+    {
+        ETI_CLASS_EXT(Config, Node, ETI_PROPERTIES
+        (
+            ETI_PROPERTY(Name),
+            ETI_PROPERTY(Enabled),
+            ETI_PROPERTY(Count),
+            ETI_PROPERTY(Ratio),
+            ETI_PROPERTY(Level),
+            ETI_PROPERTY(Channels),
+            ETI_PROPERTY(Position),
+            ETI_PROPERTY(Path),
+            ETI_PROPERTY(Values),
+            ETI_PROPERTY(Limits),
+            ETI_PROPERTY(Levels),
+            ETI_PROPERTY(Next)
+        ),
+        ETI_METHODS())
+
+    public:
+        std::string Name;
+        bool Enabled = false;
+        std::int32_t Count = 0;
+        float Ratio = 0.0f;
+        Level Level = Level::Normal;
+        Channel Channels = Channel::None;
+        Vec Position;
+        std::vector<Vec> Path;
+        std::vector<std::int32_t> Values;
+        std::map<std::string, std::int32_t> Limits;
+        std::map<test_37::Level, Vec> Levels;
+        Config* Next = nullptr;
+    };
+
+    // input split in chunks of Size bytes
+    struct Chunks
+    {
+        std::string_view Json;
+        size_t Size = 1;
+        size_t Offset = 0;
+
+        static size_t Read(void* context, char* buffer, size_t size)
+        {
+            Chunks& chunks = *static_cast<Chunks*>(context);
+            size_t count = std::min({ size, chunks.Size, chunks.Json.size() - chunks.Offset });
+            std::memcpy(buffer, chunks.Json.data() + chunks.Offset, count);
+            chunks.Offset += count;
+            return count;
+        }
+    };
+}
+ETI_ENUM_IMPL(test_37::Level)
+ETI_ENUM_FLAGS_IMPL(test_37::Channel)
+
+namespace test_37
+{
+    TEST_CASE("test_37")
+    {
+        Config config;
+        config.Id = 42;
+        config.Name = "a \"quoted\"\n\\name";
+        config.Enabled = true;
+        config.Count = -12;
+        config.Ratio = 0.25f;
+        config.Level = Level::Low;
+        config.Channels = (Channel)((std::uint8_t)Channel::Red | (std::uint8_t)Channel::Blue);
+        config.Position = { 1.5, -2.0 };
+        config.Path = { { 0.0, 1.0 }, { 2.0, 3.0 } };
+        config.Values = { 1, 2, 3 };
+        config.Limits = { { "min", -5 }, { "max", 5 } };
+        config.Levels = { { Level::Low, { 0.5, 0.5 } }, { Level::High, { 9.0, 9.0 } } };
+        config.Next = &config;
+
+        JsonWriter writer;
+        REQUIRE(writer.Write(config));
+        std::string json(writer.GetBuffer());
+        REQUIRE(json == R"({"Id":42,"Name":"a \"quoted\"\n\\name","Enabled":true,"Count":-12,"Ratio":0.25,"Level":"Low","Channels":"Red|Blue",)"
+            R"("Position":{"X":1.5,"Y":-2},"Path":[{"X":0,"Y":1},{"X":2,"Y":3}],"Values":[1,2,3],"Limits":{"max":5,"min":-5},)"
+            R"("Levels":{"Low":{"X":0.5,"Y":0.5},"High":{"X":9,"Y":9}}})");
+
+        auto check = [&config](const Config& result)
+        {
+            REQUIRE(result.Id == config.Id);
+            REQUIRE(result.Name == config.Name);
+            REQUIRE(result.Enabled == config.Enabled);
+            REQUIRE(result.Count == config.Count);
+            REQUIRE(result.Ratio == config.Ratio);
+            REQUIRE(result.Level == config.Level);
+            REQUIRE(result.Channels == config.Channels);
+            REQUIRE(result.Position == config.Position);
+            REQUIRE(result.Path == config.Path);
+            REQUIRE(result.Values == config.Values);
+            REQUIRE(result.Limits == config.Limits);
+            REQUIRE(result.Levels == config.Levels);
+            REQUIRE(result.Next == nullptr);
+        };
+
+        {
+            Config result;
+            result.Values = { 7 };
+            JsonReader reader(json);
+            REQUIRE(reader.Read(result));
+            check(result);
+        }
+
+        // chunked input, 1 byte (every token cross chunks) and 7 bytes
+        for (size_t size : { 1, 7 })
+        {
+            Chunks chunks = { json, size };
+            Config result;
+            JsonReader reader(&Chunks::Read, &chunks, 16);
+            REQUIRE(reader.Read(result));
+            check(result);
+        }
+
+        // unknown keys are skipped, missing keep their value, escapes, null
+        {
+            Config result;
+            result.Count = 3;
+            JsonReader reader(" { \"Unknown\" : { \"a\" : [ 1, { \"b\" : null } ] }, \"Name\" : \"\\u00e9\\ud83d\\ude00\\/\", \"Position\" : null,"
+                " \"Level\" : 1, \"Channels\" : \"Green|Red\" } ");
+            REQUIRE(reader.Read(result));
+            REQUIRE(result.Count == 3);
+            REQUIRE(result.Name == "\xC3\xA9\xF0\x9F\x98\x80/");
+            REQUIRE(result.Level == Level::High);
+            REQUIRE(result.Channels == (Channel)((std::uint8_t)Channel::Red | (std::uint8_t)Channel::Green));
+        }
+
+        // keys out of declaration order and escaped keys are matched by hash
+        {
+            Config result;
+            JsonReader reader(R"({"\u0043ount":5,"Id":7,"Ratio":0.5,"Name":"n"})");
+            REQUIRE(reader.Read(result));
+            REQUIRE(result.Count == 5);
+            REQUIRE(result.Id == 7);
+            REQUIRE(result.Ratio == 0.5f);
+            REQUIRE(result.Name == "n");
+        }
+
+        // repeated map key, last one wins
+        {
+            Config result;
+            JsonReader reader(R"({"Limits":{"a":1,"a":2}})");
+            REQUIRE(reader.Read(result));
+            REQUIRE(result.Limits == std::map<std::string, std::int32_t>{ { "a", 2 } });
+        }
+
+        // pull tokens
+        {
+            JsonReader reader(R"({"a":[true,null,-1.5e3],"b":"s"})");
+            REQUIRE(reader.Next() == JsonToken::BeginObject);
+            REQUIRE(reader.Next() == JsonToken::Key);
+            REQUIRE(reader.GetText() == "a");
+            REQUIRE(reader.Next() == JsonToken::BeginArray);
+            REQUIRE(reader.Next() == JsonToken::True);
+            REQUIRE(reader.Next() == JsonToken::Null);
+            REQUIRE(reader.Next() == JsonToken::Number);
+            REQUIRE(reader.GetText() == "-1.5e3");
+            REQUIRE(reader.Next() == JsonToken::EndArray);
+            REQUIRE(reader.Next() == JsonToken::Key);
+            REQUIRE(reader.Next() == JsonToken::String);
+            REQUIRE(reader.GetText() == "s");
+            REQUIRE(reader.Next() == JsonToken::EndObject);
+            REQUIRE(reader.Next() == JsonToken::End);
+        }
+
+        // invalid json
+        for (std::string_view invalid : { "", "{", "{\"Count\":1,}", "{\"Count\" 1}", "{\"Count\":1}}", "[1 2]",
+            "{\"Count\":\"1\"}", "{\"Count\":1.5}", "{\"Count\":1 \"Id\":2}", "{\"Count\":}", "{\"Values\":[1 2]}", "{\"Count\",1}", "{\"Level\":\"Unknown\"}", "{\"Name\":\"\\x\"}", "{\"Values\":[1,]}" })
+        {
+            Config result;
+            JsonReader reader(invalid);
+            REQUIRE(reader.Read(result) == false);
+        }
+    }
+}
+
+namespace test_38
+{
+    struct Texts
+    {
+        ETI_STRUCT_EXT(Texts,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Values),
+                ETI_PROPERTY(Numbers)
+            ),
+            ETI_METHODS())
+
+        std::vector<std::string> Values;
+        std::vector<double> Numbers;
+    };
+
+    TEST_CASE("test_38")
+    {
+        // strings of all sizes with escapes and structural characters, so they cross 64 bytes blocks at every offset
+        Texts texts;
+        std::string_view pattern = "a\"{,\\}:[\\\\\"]x\n";
+        for (size_t size = 0; size < 140; ++size)
+        {
+            std::string value;
+            for (size_t i = 0; i < size; ++i)
+                value.push_back(pattern[(i * 7 + size) % pattern.size()]);
+            texts.Values.push_back(value);
+            texts.Numbers.push_back((double)size * -1.25e-3);
+        }
+
+        JsonWriter writer;
+        writer.Write(texts);
+        std::string json(writer.GetBuffer());
+
+        {
+            Texts result;
+            JsonReader reader(json);
+            REQUIRE(reader.Read(result));
+            REQUIRE(result.Values == texts.Values);
+            REQUIRE(result.Numbers == texts.Numbers);
+        }
+        for (size_t size : { 1, 3, 13, 64, 100 })
+        {
+            test_37::Chunks chunks = { json, size };
+            Texts result;
+            JsonReader reader(&test_37::Chunks::Read, &chunks, 64);
+            REQUIRE(reader.Read(result));
+            REQUIRE(result.Values == texts.Values);
+            REQUIRE(result.Numbers == texts.Numbers);
+        }
+
+        // numbers, fast paths agree with from_chars
+        for (std::string_view text : { "0", "-0", "1", "0.1", "3.14159", "-2.5e-3", "1e22", "1e23", "123456789012345678", "9007199254740993",
+            "1.7976931348623157e308", "4.9e-324", "0.30000000000000004", "123.456e-7", "1E5", "1e+5" })
+        {
+            double value = 0.0;
+            double expected = 0.0;
+            REQUIRE(json::internal::ParseFloat<double>(text, &value));
+            std::from_chars(text.data(), text.data() + text.size(), expected);
+            REQUIRE(value == expected);
+
+            // out of float range fail
+            float floatValue = 0.0f;
+            float floatExpected = 0.0f;
+            bool floatValid = std::from_chars(text.data(), text.data() + text.size(), floatExpected).ec == std::errc();
+            REQUIRE(json::internal::ParseFloat<float>(text, &floatValue) == floatValid);
+            REQUIRE((!floatValid || floatValue == floatExpected));
+        }
+        for (std::string_view text : { "", "-", ".5", "1.", "1e", "1x", "--1" })
+        {
+            double value;
+            REQUIRE(json::internal::ParseFloat<double>(text, &value) == false);
+        }
+
+        std::int8_t s8 = 0;
+        REQUIRE(json::internal::ParseInteger<std::int8_t>("-128", &s8));
+        REQUIRE(s8 == -128);
+        REQUIRE(json::internal::ParseInteger<std::int8_t>("128", &s8) == false);
+        std::int64_t s64 = 0;
+        REQUIRE(json::internal::ParseInteger<std::int64_t>("-9223372036854775808", &s64));
+        REQUIRE(s64 == std::numeric_limits<std::int64_t>::min());
+        std::uint64_t u64 = 0;
+        REQUIRE(json::internal::ParseInteger<std::uint64_t>("18446744073709551615", &u64));
+        REQUIRE(u64 == std::numeric_limits<std::uint64_t>::max());
+        REQUIRE(json::internal::ParseInteger<std::uint64_t>("18446744073709551616", &u64) == false);
+        REQUIRE(json::internal::ParseInteger<std::uint64_t>("-1", &u64) == false);
+    }
+}
+
+namespace test_39
+{
+    using namespace test_36;
+
+    TEST_CASE("test_39")
+    {
+        Scene scene;
+        scene.Id = 7;
+        scene.Flags = 0xF0F0;
+        scene.Origin = { 1.5f, -2.5f };
+        scene.Kind = Shape::Square;
+        scene.Title = "scene";
+        scene.Parent = &scene;
+        scene.Points = { { 1.0f, 2.0f }, { 3.0f, 4.0f }, { 5.0f, 6.0f } };
+        scene.Items = { { 1, "first", { 1.0f, 1.0f } }, { 2, std::string(64, 'x'), { 2.0f, 2.0f } } };
+        scene.Lookup = { { "a", 1 }, { "b", 2 }, { "c", 3 } };
+        Point point = { 8.0f, 9.0f };
+
+        ArchiveWriter writer;
+        REQUIRE(writer.Write(scene) == 0);
+        REQUIRE(writer.Write(point) == 1);
+        std::span<const std::byte> buffer = writer.Finish();
+
+        // read in place, from memory and from mapped file
+        auto check = [&](const Archive& archive)
+        {
+            REQUIRE(archive.GetObjectCount() == 2);
+            const Point* archivePoint = archive.Get<Point>(1);
+            REQUIRE(archivePoint != nullptr);
+            REQUIRE(*archivePoint == point);
+            REQUIRE(archive.Get<Point>(0) == nullptr);
+
+            ObjectView view = archive.GetObject(0);
+            REQUIRE(view.GetType() == &TypeOf<Scene>());
+            REQUIRE(*view.Get<std::uint32_t>("Id") == 7);
+            REQUIRE(*view.Get<std::uint32_t>("Flags") == 0xF0F0);
+            REQUIRE(*view.Get<Point>("Origin") == scene.Origin);
+            REQUIRE(*view.Get<Shape>("Kind") == Shape::Square);
+            REQUIRE(view.GetMember("Title").AsString() == "scene");
+            // wrong type, pointer and unknown members
+            REQUIRE(view.Get<float>("Id") == nullptr);
+            REQUIRE(view.GetMember("Parent").IsValid() == false);
+            REQUIRE(view.GetMember("Unknown").IsValid() == false);
+
+            std::span<const Point> points = view.GetMember("Points").AsArray().As<Point>();
+            REQUIRE(points.size() == 3);
+            REQUIRE(points[2] == scene.Points[2]);
+
+            ArrayView items = view.GetMember("Items").AsArray();
+            REQUIRE(items.GetSize() == 2);
+            REQUIRE(*items[1].Get<int>("Id") == 2);
+            REQUIRE(items[1].GetMember("Name").AsString() == std::string(64, 'x'));
+            REQUIRE(*items[1].Get<Point>("Position") == scene.Items[1].Position);
+
+            MapView lookup = view.GetMember("Lookup").AsMap();
+            REQUIRE(lookup.GetSize() == 3);
+            std::span<const int> values = lookup.Values.As<int>();
+            for (size_t i = 0; i < 3; ++i)
+            {
+                auto it = scene.Lookup.find(std::string(lookup.Keys[i].AsString()));
+                REQUIRE(it != scene.Lookup.end());
+                REQUIRE(values[i] == it->second);
+            }
+        };
+
+        Archive archive;
+        REQUIRE(archive.Open(buffer));
+        check(archive);
+
+        const char* path = "eti_test_39.archive";
+        FILE* file = std::fopen(path, "wb");
+        REQUIRE(file != nullptr);
+        REQUIRE(std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size());
+        std::fclose(file);
+        {
+            MappedFile mapped;
+            REQUIRE(mapped.Open(path));
+            Archive mappedArchive;
+            REQUIRE(mappedArchive.Open(mapped.GetData()));
+            check(mappedArchive);
+        }
+        std::remove(path);
+
+        archive::Header header;
+        std::memcpy(&header, buffer.data(), sizeof(header));
+        std::vector<std::byte> copy(buffer.begin(), buffer.end());
+
+        // truncated
+        REQUIRE(archive.Open(std::span<const std::byte>(copy).first(copy.size() - 1)) == false);
+
+        // changed layout
+        archive::TypeEntry* types = reinterpret_cast<archive::TypeEntry*>(copy.data() + header.TypesOffset);
+        types[0].LayoutHash ^= 1;
+        REQUIRE(archive.Open(copy) == false);
+        types[0].LayoutHash ^= 1;
+        REQUIRE(archive.Open(copy));
+
+        // corrupted offset, view is invalid
+        const archive::ObjectEntry* objects = reinterpret_cast<const archive::ObjectEntry*>(copy.data() + header.ObjectsOffset);
+        std::byte* title = copy.data() + objects[0].Offset + TypeOf<Scene>().GetProperty("Title")->Offset;
+        archive::RelativeSpan span = { (std::int64_t)copy.size(), 1 };
+        std::memcpy(title, &span, sizeof(span));
+        REQUIRE(archive.GetObject(0).GetMember("Title").AsString().empty());
+        REQUIRE(archive.GetObject(0).GetMember("Points").AsArray().GetSize() == 3);
+    }
+}
+
+namespace test_40
+{
+    using test_36::Point;
+
+    struct PartV1
+    {
+        ETI_STRUCT_EXT(PartV1,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Id),
+                ETI_PROPERTY(Weight)
+            ),
+            ETI_METHODS())
+
+        int Id = 0;
+        float Weight = 0.0f;
+
+        bool operator==(const PartV1&) const = default;
+    };
+
+    // reordered, new field
+    struct PartV2
+    {
+        ETI_STRUCT_EXT(PartV2,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Weight),
+                ETI_PROPERTY(Id),
+                ETI_PROPERTY(Color)
+            ),
+            ETI_METHODS())
+
+        float Weight = 0.0f;
+        int Id = 0;
+        std::uint32_t Color = 0xFF;
+
+        bool operator==(const PartV2&) const = default;
+    };
+
+    struct ModelV1
+    {
+        ETI_STRUCT_EXT(ModelV1,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Id),
+                ETI_PROPERTY(Name),
+                ETI_PROPERTY(Origin),
+                ETI_PROPERTY(Count),
+                ETI_PROPERTY(Removed),
+                ETI_PROPERTY(Parts),
+                ETI_PROPERTY(Dropped),
+                ETI_PROPERTY(Notes)
+            ),
+            ETI_METHODS())
+
+        std::uint32_t Id = 0;
+        std::string Name;
+        Point Origin;
+        std::int32_t Count = 0;
+        std::int32_t Removed = 0;
+        std::vector<PartV1> Parts;
+        std::vector<PartV1> Dropped;
+        std::map<std::string, int> Notes;
+    };
+
+    // Id moved, Count type changed, Removed/Dropped/Notes removed, Scale/Label added, Parts element layout changed
+    struct ModelV2
+    {
+        ETI_STRUCT_EXT(ModelV2,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Name),
+                ETI_PROPERTY(Id),
+                ETI_PROPERTY(Origin),
+                ETI_PROPERTY(Count),
+                ETI_PROPERTY(Scale),
+                ETI_PROPERTY(Label),
+                ETI_PROPERTY(Parts)
+            ),
+            ETI_METHODS())
+
+        std::string Name;
+        std::uint32_t Id = 0;
+        Point Origin;
+        std::int64_t Count = -1;
+        float Scale = 2.0f;
+        std::string Label = "default";
+        std::vector<PartV2> Parts;
+    };
+
+    TEST_CASE("test_40")
+    {
+        ModelV1 model;
+        model.Id = 42;
+        model.Name = "model";
+        model.Origin = { 1.0f, 2.0f };
+        model.Count = 3;
+        model.Removed = 4;
+        model.Parts = { { 1, 0.5f }, { 2, 1.5f } };
+        model.Dropped = { { 3, 2.5f } };
+        model.Notes = { { "a", 1 } };
+
+        const binary::Plan& planV1 = binary::GetPlan(TypeOf<ModelV1>());
+        REQUIRE(planV1.Fields.size() == 9);
+        REQUIRE(planV1.Fields[2].Id != planV1.Fields[3].Id);
+        REQUIRE(planV1.LayoutHash != binary::GetPlan(TypeOf<ModelV2>()).LayoutHash);
+
+        // schema written once per layout
+        BinaryWriter writer;
+        writer.Write(model);
+        size_t firstSize = writer.GetBuffer().size();
+        writer.Write(model);
+        std::uint64_t schemaSize = 0;
+        std::memcpy(&schemaSize, writer.GetBuffer().data() + sizeof(std::uint64_t), sizeof(schemaSize));
+        REQUIRE(schemaSize != 0);
+        REQUIRE(writer.GetBuffer().size() - firstSize == firstSize - schemaSize);
+
+        // same layout
+        ModelV1 same;
+        BinaryReader sameReader(writer.GetBuffer());
+        REQUIRE(sameReader.Read(same));
+        REQUIRE(sameReader.Read(same));
+        REQUIRE(sameReader.IsEnd());
+        REQUIRE(same.Removed == 4);
+        REQUIRE(same.Dropped == model.Dropped);
+        REQUIRE(same.Notes == model.Notes);
+
+        // schema with same layout hash but other fields (first field id changed) do not affect other readers
+        std::vector<std::byte> forged(writer.GetBuffer().begin(), writer.GetBuffer().begin() + firstSize);
+        size_t firstFieldId = sizeof(std::uint64_t) * 2 + sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+        forged[firstFieldId] ^= std::byte{ 0xFF };
+        ModelV2 forgedResult;
+        BinaryReader forgedReader(forged);
+        REQUIRE(forgedReader.Read(forgedResult));
+        REQUIRE(forgedResult.Id == 0);
+        REQUIRE(forgedResult.Name == "model");
+
+        // migrated
+        BinaryReader reader(writer.GetBuffer());
+        for (int i = 0; i < 2; ++i)
+        {
+            ModelV2 result;
+            result.Count = 7;
+            result.Scale = 9.0f;
+            result.Label = "changed";
+            // existing elements are replaced by default constructed ones
+            result.Parts = { { 9.0f, 9, 0 }, { 9.0f, 9, 0 }, { 9.0f, 9, 0 } };
+            REQUIRE(reader.Read(result));
+            REQUIRE(result.Id == 42);
+            REQUIRE(result.Name == "model");
+            REQUIRE(result.Origin == model.Origin);
+            REQUIRE(result.Count == -1);
+            REQUIRE(result.Scale == 2.0f);
+            REQUIRE(result.Label == "default");
+            REQUIRE(result.Parts.size() == 2);
+            REQUIRE(result.Parts[1].Id == 2);
+            REQUIRE(result.Parts[1].Weight == 1.5f);
+            REQUIRE(result.Parts[0].Color == 0xFF);
+            REQUIRE(result.Parts[1].Color == 0xFF);
+        }
+        REQUIRE(reader.IsEnd());
+
+        // truncated data fail at any size
+        std::span<const std::byte> buffer = writer.GetBuffer();
+        for (size_t size = 0; size < firstSize; ++size)
+        {
+            ModelV2 truncated;
+            BinaryReader truncatedReader(buffer.first(size));
+            REQUIRE(truncatedReader.Read(truncated) == false);
+        }
+
+        // migrated map with corrupted key (repeated) fail
+        std::map<std::string, PartV1> parts = { { "a", { 1, 0.5f } }, { "b", { 2, 1.5f } } };
+        BinaryWriter partsWriter;
+        partsWriter.Write(parts);
+        std::map<std::string, PartV2> partsResult;
+        BinaryReader partsReader(partsWriter.GetBuffer());
+        REQUIRE(partsReader.Read(partsResult));
+        REQUIRE(partsResult.size() == 2);
+        REQUIRE(partsResult["b"].Id == 2);
+        std::vector<std::byte> repeated(partsWriter.GetBuffer().begin(), partsWriter.GetBuffer().end());
+        auto keyB = std::find(repeated.rbegin(), repeated.rend(), std::byte{ 'b' });
+        REQUIRE(keyB != repeated.rend());
+        *keyB = std::byte{ 'a' };
+        BinaryReader repeatedReader(repeated);
+        REQUIRE(repeatedReader.Read(partsResult) == false);
+    }
+}
+
+namespace test_41
+{
+    TEST_CASE("test_41")
+    {
+        const Type* types[] = { &TypeOf<int>(), &TypeOf<std::string>(), &TypeOf<test_36::Entity>(), &TypeOf<test_36::Scene>(), &TypeOf<std::vector<test_36::Point>>() };
+
+        // dense and unique
+        size_t count = GetTypeIndexCount();
+        std::vector<bool> used(count);
+        for (const Type* type : types)
+        {
+            REQUIRE(type->Index < count);
+            REQUIRE(used[type->Index] == false);
+            used[type->Index] = true;
+        }
+
+        test_36::Scene scene;
+        test_36::Entity& entity = scene;
+        REQUIRE(entity.GetType().Index == TypeOf<test_36::Scene>().Index);
+
+        // every index is a registered type
+        for (size_t index = 0; index < count; ++index)
+        {
+            const Type* type = Repository::Instance().GetTypeByIndex(index);
+            REQUIRE(type != nullptr);
+            REQUIRE(type->Index == index);
+        }
+        REQUIRE(Repository::Instance().GetTypeByIndex(count) == nullptr);
+        REQUIRE(Repository::Instance().GetTypeByIndex(InvalidIndex) == nullptr);
+    }
+}
+
+namespace test_42
+{
+    struct ClashA {};
+    struct ClashB {};
+}
+
+// simulate a hash collision
+template<>
+constexpr eti::TypeId eti::GetTypeId<test_42::ClashB>()
+{
+    return GetTypeId<test_42::ClashA>();
+}
+
+namespace test_42
+{
+    static_assert(HaveUniqueTypeIds<int, float, std::string, test_36::Scene, test_36::Entity>());
+    static_assert(HaveUniqueTypeIds<ClashA, ClashA>());
+    static_assert(HaveUniqueTypeIds<ClashA, int, ClashB>() == false);
+
+    // 128 bits ids, low 64 bits are the 64 bits id
+    static_assert(utils::GetStringHashAs<TypeId128>("Foo").Low == utils::GetStringHashAs<std::uint64_t>("Foo"));
+    static_assert(utils::GetStringHashAs<TypeId128>("Foo") != utils::GetStringHashAs<TypeId128>("Goo"));
+    static_assert(TypeId128(1, 2) < TypeId128(1, 3));
+
+    TEST_CASE("test_42")
+    {
+        TypeOf<test_36::Scene>();
+        TypeOf<test_37::Config>();
+        REQUIRE(Repository::Instance().AuditCollisions().empty());
+
+        std::vector<std::pair<TypeId, std::string_view>> entries = { { 2, "b" }, { 1, "c" }, { 1, "a" }, { 1, "a" } };
+        std::vector<IdCollision> collisions;
+        internal::AppendCollisions(entries, &TypeOf<test_36::Scene>(), collisions);
+        REQUIRE(collisions.size() == 1);
+        REQUIRE(collisions[0].Id == TypeId(1));
+        REQUIRE(collisions[0].First == "a");
+        REQUIRE(collisions[0].Second == "c");
+        REQUIRE(collisions[0].Owner == &TypeOf<test_36::Scene>());
+
+        // colliding types registered, first one kept by id and pair reported
+        const Type& clashA = TypeOf<ClashA>();
+        const Type& clashB = TypeOf<ClashB>();
+        REQUIRE(clashA.Id == clashB.Id);
+        REQUIRE(Repository::Instance().GetType(clashA.Id) == &clashA);
+        REQUIRE(Repository::Instance().GetTypeByIndex(clashB.Index) == &clashB);
+        std::vector<IdCollision> registered = Repository::Instance().AuditCollisions();
+        REQUIRE(registered.size() == 1);
+        REQUIRE(registered[0].Id == clashA.Id);
+        REQUIRE(registered[0].Owner == nullptr);
+        REQUIRE(std::minmax(registered[0].First, registered[0].Second) == std::minmax(clashA.Name, clashB.Name));
+    }
+}
+
+namespace test_43
+{
+    struct alignas(64) Particle
+    {
+        ETI_STRUCT_EXT(Particle,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Name),
+                ETI_PROPERTY(Life)
+            ),
+            ETI_METHODS())
+
+        std::string Name = "spark";
+        float Life = 1.0f;
+    };
+
+    struct Fragile
+    {
+        Fragile() { if (Fail) throw std::runtime_error("Fragile"); }
+
+        static inline bool Fail = false;
+    };
+
+    TEST_CASE("test_43")
+    {
+        const Type& type = TypeOf<Particle>();
+        PoolStats stats = type.GetPoolStats();
+        REQUIRE(stats.BlockSize == 64 * ((sizeof(Particle) + 63) / 64));
+        REQUIRE(stats.SlabSize % stats.BlockSize == 0);
+
+        // constructed, aligned, freed block reused first
+        Particle* p = static_cast<Particle*>(type.NewPooled());
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) % 64 == 0);
+        REQUIRE(p->Name == "spark");
+        REQUIRE(p->Life == 1.0f);
+        p->Name = "a long name to allocate string storage";
+        type.DeletePooled(p);
+        Particle* q = static_cast<Particle*>(type.NewPooled());
+        REQUIRE(q == p);
+        REQUIRE(q->Name == "spark");
+        type.DeletePooled(q);
+        REQUIRE(type.GetPoolStats().SlabsAllocated >= 1);
+
+        // allocated in a thread, deleted in others
+        std::vector<void*> objs;
+        size_t count = 2 * stats.SlabSize / stats.BlockSize;
+        std::thread([&] { for (size_t i = 0; i < count; ++i) objs.push_back(type.NewPooled()); }).join();
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                for (size_t i = t; i < objs.size(); i += 4)
+                    type.DeletePooled(objs[i]);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        size_t slabs = type.GetPoolStats().SlabsAllocated;
+        REQUIRE(slabs >= 2);
+
+        // given back blocks are reused, no more slabs
+        std::thread([&] { for (size_t i = 0; i < count; ++i) objs[i] = type.NewPooled(); for (void* obj : objs) type.DeletePooled(obj); }).join();
+        REQUIRE(type.GetPoolStats().SlabsAllocated == slabs);
+
+        // throwing constructor give its block back
+        const Type& fragileType = TypeOf<Fragile>();
+        void* fragile = fragileType.NewPooled();
+        fragileType.DeletePooled(fragile);
+        Fragile::Fail = true;
+        REQUIRE_THROWS(fragileType.NewPooled());
+        Fragile::Fail = false;
+        REQUIRE(fragileType.NewPooled() == fragile);
+        fragileType.DeletePooled(fragile);
+    }
+}
+
+namespace test_44
+{
+    class Shape
+    {
+        ETI_BASE_EXT(Shape, ETI_PROPERTIES(), ETI_METHODS())
+
+    public:
+        virtual ~Shape() { ++Destructed; }
+        virtual int GetSides() const { return 0; }
+
+        static inline int Destructed = 0;
+    };
+
+    class Square : public Shape
+    {
+        ETI_CLASS_EXT(Square, Shape, ETI_PROPERTIES(), ETI_METHODS())
+
+    public:
+        int GetSides() const override { return 4; }
+
+        std::string Name = "a square with a name long enough to allocate";
+    };
+
+    struct alignas(32) Vec
+    {
+        float X = 1.0f;
+    };
+
+    TEST_CASE("test_44")
+    {
+        REQUIRE(TypeOf<Vec>().HaveFlag(TypeFlags::TriviallyDestructible));
+        REQUIRE(TypeOf<Square>().HaveFlag(TypeFlags::TriviallyDestructible) == false);
+
+        Arena arena(1024);
+        Shape::Destructed = 0;
+
+        // polymorphic, constructed from runtime type
+        const Type& squareType = TypeOf<Square>();
+        Shape* shape = Cast<Shape>(static_cast<Square*>(arena.Construct(squareType)));
+        REQUIRE(shape->GetSides() == 4);
+        REQUIRE(shape->GetType() == squareType);
+        Square* copy = static_cast<Square*>(arena.CopyConstruct(squareType, shape));
+        REQUIRE(copy->Name == static_cast<Square*>(shape)->Name);
+
+        // aligned, trivially destructible are not tracked
+        for (int i = 0; i < 100; ++i)
+        {
+            Vec* vec = static_cast<Vec*>(arena.Construct(TypeOf<Vec>()));
+            REQUIRE(reinterpret_cast<std::uintptr_t>(vec) % 32 == 0);
+            REQUIRE(vec->X == 1.0f);
+        }
+        arena.New<std::string>("typed");
+        REQUIRE(arena.GetDestructCount() == 3);
+
+        // oversized
+        void* big = arena.Allocate(4096, 64);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(big) % 64 == 0);
+
+        size_t capacity = arena.GetCapacity();
+        REQUIRE(arena.GetUsedSize() >= 100 * 32 + 4096);
+        arena.Reset();
+        REQUIRE(Shape::Destructed == 2);
+        REQUIRE(arena.GetUsedSize() == 0);
+        REQUIRE(arena.GetDestructCount() == 0);
+
+        // blocks reused
+        arena.Construct(squareType);
+        REQUIRE(arena.GetCapacity() == capacity);
+    }
+}
+
+namespace test_45
+{
+    // live instances count, copy and default constructors throw once ThrowAfter constructions are done (-1 never)
+    struct Counted
+    {
+        Counted() { Construct(); }
+        Counted(const Counted& other) : Value(other.Value) { Construct(); }
+        Counted(Counted&& other) noexcept : Value(other.Value) { ++Live; }
+        Counted& operator=(const Counted&) = default;
+        ~Counted() { --Live; }
+
+        void Construct()
+        {
+            if (ThrowAfter == 0)
+                throw std::runtime_error("Counted");
+            if (ThrowAfter > 0)
+                --ThrowAfter;
+            ++Live;
+        }
+
+        int Value = 0;
+
+        static inline int Live = 0;
+        static inline int ThrowAfter = -1;
+    };
+
+    TEST_CASE("test_45")
+    {
+        // trivial, memset/memcpy
+        const Type& intType = TypeOf<int>();
+        int ints[8];
+        std::memset(ints, 0xff, sizeof(ints));
+        intType.ConstructN(ints, 8);
+        REQUIRE(std::count(std::begin(ints), std::end(ints), 0) == 8);
+        int src[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        intType.CopyConstructN(src, ints, 8);
+        REQUIRE(std::equal(std::begin(ints), std::end(ints), std::begin(src)));
+        intType.DestructN(ints, 8);
+
+        // default member initializers are not trivial
+        const Type& pointType = TypeOf<test_36::Point>();
+        test_36::Point points[4];
+        points[0].X = 5.0f;
+        pointType.DestructN(points, 4);
+        pointType.ConstructN(points, 4);
+        REQUIRE(points[0].X == 0.0f);
+
+        // per element
+        const Type& stringType = TypeOf<std::string>();
+        alignas(std::string) std::byte a[3 * sizeof(std::string)];
+        alignas(std::string) std::byte b[3 * sizeof(std::string)];
+        stringType.ConstructN(a, 3);
+        std::string* strings = reinterpret_cast<std::string*>(a);
+        REQUIRE(strings[2].empty());
+        strings[1] = "a string long enough to be allocated on heap";
+        stringType.CopyConstructN(a, b, 3);
+        REQUIRE(reinterpret_cast<std::string*>(b)[1] == strings[1]);
+        stringType.DestructN(b, 3);
+        stringType.MoveConstructN(a, b, 3);
+        REQUIRE(reinterpret_cast<std::string*>(b)[1] == "a string long enough to be allocated on heap");
+        stringType.DestructN(a, 3);
+        stringType.DestructN(b, 3);
+
+        REQUIRE(TypeOf<std::unique_ptr<int>>().HaveCopyConstructN() == false);
+        REQUIRE(TypeOf<std::unique_ptr<int>>().HaveMoveN());
+
+        // throwing element, already constructed ones are destructed
+        const Type& countedType = TypeOf<Counted>();
+        alignas(Counted) std::byte c[4 * sizeof(Counted)];
+        alignas(Counted) std::byte d[4 * sizeof(Counted)];
+        Counted::ThrowAfter = 2;
+        REQUIRE_THROWS(countedType.ConstructN(c, 4));
+        REQUIRE(Counted::Live == 0);
+        Counted::ThrowAfter = -1;
+        countedType.ConstructN(c, 4);
+        Counted::ThrowAfter = 3;
+        REQUIRE_THROWS(countedType.CopyConstructN(c, d, 4));
+        REQUIRE(Counted::Live == 4);
+        Counted::ThrowAfter = -1;
+        countedType.DestructN(c, 4);
+        REQUIRE(Counted::Live == 0);
+    }
+}
+
+namespace test_46
+{
+    struct Padded
+    {
+        std::uint8_t A;
+        std::uint32_t B;
+    };
+
+    struct Packed
+    {
+        std::uint32_t A;
+        std::uint32_t B;
+    };
+
+    struct Handle
+    {
+        Handle() = default;
+        Handle(Handle&&) noexcept {}
+        ~Handle() {}
+        int* Ptr = nullptr;
+    };
+}
+
+template<>
+struct eti::IsTriviallyRelocatable<test_46::Handle> : std::true_type {};
+
+namespace test_46
+{
+    TEST_CASE("test_46")
+    {
+        constexpr TypeFlags all = TypeFlags::TriviallyDestructible | TypeFlags::TriviallyCopyable | TypeFlags::StandardLayout | TypeFlags::PaddingFree | TypeFlags::TriviallyRelocatable;
+        REQUIRE(TypeOf<int>().Flags == all);
+        REQUIRE(TypeOf<Packed>().Flags == all);
+        REQUIRE(TypeOf<Padded>().HaveFlag(TypeFlags::PaddingFree) == false);
+        REQUIRE(TypeOf<Padded>().HaveFlag(TypeFlags::TriviallyCopyable));
+        REQUIRE(TypeOf<float>().HaveFlag(TypeFlags::PaddingFree) == false);
+
+        const Type& stringType = TypeOf<std::string>();
+        REQUIRE(stringType.HaveFlag(TypeFlags::TriviallyCopyable) == false);
+        REQUIRE(stringType.HaveFlag(TypeFlags::TriviallyDestructible) == false);
+        REQUIRE(stringType.HaveFlag(TypeFlags::TriviallyRelocatable) == false);
+
+        // user and std specializations
+        REQUIRE(TypeOf<Handle>().HaveFlag(TypeFlags::TriviallyRelocatable));
+        REQUIRE(TypeOf<Handle>().HaveFlag(TypeFlags::TriviallyCopyable) == false);
+        REQUIRE(TypeOf<std::unique_ptr<int>>().HaveFlag(TypeFlags::TriviallyRelocatable));
+
+        // polymorphic
+        REQUIRE(TypeOf<test_44::Shape>().HaveFlag(TypeFlags::StandardLayout) == false);
+        REQUIRE(TypeOf<test_44::Shape>().HaveFlag(TypeFlags::TriviallyRelocatable) == false);
+
+        // trivially copyable use memcpy, binary plan is trivial only for trivially copyable types
+        Arena arena;
+        Packed packed = { 1, 2 };
+        REQUIRE(static_cast<Packed*>(arena.CopyConstruct(TypeOf<Packed>(), &packed))->B == 2);
+        REQUIRE(binary::GetPlan(TypeOf<test_36::Point>()).IsTrivial);
+    }
+}
+
+namespace test_47
+{
+    struct NoDefault
+    {
+        explicit NoDefault(int value) : Value(value) {}
+        int Value;
+    };
+
+    TEST_CASE("test_47")
+    {
+        // move gated on move constructible
+        REQUIRE(TypeOf<NoDefault>().HaveMove());
+        REQUIRE(TypeOf<NoDefault>().HaveRelocate());
+        REQUIRE(TypeOf<NoDefault>().HaveConstruct() == false);
+        REQUIRE(TypeOf<std::mutex>().HaveMove() == false);
+        REQUIRE(TypeOf<std::mutex>().HaveRelocate() == false);
+
+        // trivially relocatable, overlapping
+        const Type& ptrType = TypeOf<std::unique_ptr<int>>();
+        std::vector<std::unique_ptr<int>> ptrs(6);
+        for (int i = 0; i < 4; ++i)
+            ptrs[i] = std::make_unique<int>(i);
+        std::unique_ptr<int>* data = ptrs.data();
+        ptrType.DestructN(data + 4, 2);
+        ptrType.Relocate(data, data + 2, 4);
+        ptrType.ConstructN(data, 2);
+        REQUIRE(data[0] == nullptr);
+        REQUIRE(*data[2] == 0);
+        REQUIRE(*data[5] == 3);
+
+        // move and destruct, overlapping both ways
+        const Type& stringType = TypeOf<std::string>();
+        std::vector<std::string> strings = { "zero", "one", "two", "a long string to allocate on heap", "four" };
+        std::string* str = strings.data();
+        stringType.Destruct(str);
+        stringType.Relocate(str + 1, str, 4);
+        stringType.ConstructN(str + 4, 1);
+        REQUIRE(strings == std::vector<std::string>{ "one", "two", "a long string to allocate on heap", "four", "" });
+        stringType.Destruct(str + 4);
+        stringType.Relocate(str, str + 1, 4);
+        stringType.Construct(str);
+        REQUIRE(strings == std::vector<std::string>{ "", "one", "two", "a long string to allocate on heap", "four" });
+    }
+}
+
+namespace test_48
+{
+    TEST_CASE("test_48")
+    {
+        // runtime type only
+        const Type& itemType = *Repository::Instance().GetType(TypeOf<test_36::Item>().Id);
+        DynamicArray items(itemType);
+        REQUIRE(items.IsEmpty());
+        REQUIRE(items.GetStride() == sizeof(test_36::Item));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            test_36::Item* item = static_cast<test_36::Item*>(items.PushBack());
+            item->Id = i;
+            item->Name = "item with a name long enough to allocate " + std::to_string(i);
+        }
+        REQUIRE(items.GetSize() == 100);
+        REQUIRE(items.GetCapacity() >= 100);
+        REQUIRE(static_cast<test_36::Item*>(items.Get(99))->Name.ends_with("99"));
+
+        // bulk insert and erase
+        test_36::Item values[3];
+        values[0].Id = 1000;
+        values[2].Id = 1002;
+        items.Insert(10, values, 3);
+        items.Insert(0, 2);
+        REQUIRE(items.GetSize() == 105);
+        std::span<test_36::Item> span = items.AsSpan<test_36::Item>();
+        REQUIRE(span[0].Id == 0);
+        REQUIRE(span[2].Id == 0);
+        REQUIRE(span[12].Id == 1000);
+        REQUIRE(span[14].Id == 1002);
+        REQUIRE(span[15].Id == 10);
+        items.Erase(0, 15);
+        REQUIRE(items.AsSpan<test_36::Item>()[0].Id == 10);
+        items.Erase(0, 10);
+        items.PopBack();
+        REQUIRE(items.GetSize() == 79);
+
+        // member access by property offset
+        const Property& idProperty = *itemType.GetProperty("Id");
+        MemberView<int> ids = items.GetMembers<int>(idProperty);
+        int sum = 0;
+        for (size_t i = 0; i < ids.GetSize(); ++i)
+            sum += ids[i];
+        REQUIRE(sum == (20 + 98) * 79 / 2);
+        *static_cast<int*>(items.GetMember(0, idProperty)) = -1;
+        REQUIRE(ids[0] == -1);
+
+        // copy, move
+        DynamicArray copy = items;
+        REQUIRE(copy.GetSize() == 79);
+        REQUIRE(copy.AsSpan<test_36::Item>()[78].Name == items.AsSpan<test_36::Item>()[78].Name);
+        DynamicArray moved = std::move(copy);
+        REQUIRE(copy.GetSize() == 0);
+        REQUIRE(moved.GetSize() == 79);
+        moved.Resize(5);
+        REQUIRE(moved.GetSize() == 5);
+        moved.Resize(10);
+        REQUIRE(moved.AsSpan<test_36::Item>()[9].Name.empty());
+        moved.Clear();
+        REQUIRE(moved.IsEmpty());
+
+        // trivially relocatable, over aligned
+        DynamicArray ptrs(TypeOf<std::unique_ptr<int>>());
+        ptrs.Reserve(1);
+        for (int i = 0; i < 10; ++i)
+            *static_cast<std::unique_ptr<int>*>(ptrs.Insert(0)) = std::make_unique<int>(i);
+        REQUIRE(*ptrs.AsSpan<std::unique_ptr<int>>()[0] == 9);
+        DynamicArray particles(TypeOf<test_43::Particle>());
+        particles.Resize(3);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(particles.GetData()) % 64 == 0);
+
+        // throwing copy leave array unchanged, in place and growing
+        using test_45::Counted;
+        {
+            DynamicArray counteds(TypeOf<Counted>());
+            counteds.Reserve(8);
+            counteds.Resize(3);
+            for (size_t i = 0; i < 3; ++i)
+                static_cast<Counted*>(counteds.Get(i))->Value = (int)i;
+            Counted src[2];
+            Counted::ThrowAfter = 1;
+            REQUIRE_THROWS(counteds.Insert(1, src, 2));
+            Counted::ThrowAfter = -1;
+            REQUIRE(counteds.GetSize() == 3);
+            REQUIRE(Counted::Live == 5);
+            REQUIRE(counteds.AsSpan<Counted>()[1].Value == 1);
+            REQUIRE(counteds.AsSpan<Counted>()[2].Value == 2);
+
+            counteds.Resize(8);
+            Counted::ThrowAfter = 1;
+            REQUIRE_THROWS(counteds.Insert(1, src, 2));
+            REQUIRE_THROWS(counteds.Insert(8, 1));
+            Counted::ThrowAfter = -1;
+            REQUIRE(counteds.GetSize() == 8);
+            REQUIRE(counteds.GetCapacity() == 8);
+            REQUIRE(Counted::Live == 10);
+            REQUIRE(counteds.AsSpan<Counted>()[2].Value == 2);
+        }
+        REQUIRE(Counted::Live == 0);
+    }
+}
+
+namespace test_49
+{
+    struct Body
+    {
+        ETI_STRUCT_EXT(Body,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(X),
+                ETI_PROPERTY(Y),
+                ETI_PROPERTY(Mass),
+                ETI_PROPERTY(Name),
+                ETI_PROPERTY(Parent)
+            ),
+            ETI_METHODS())
+
+        float X = 0.0f;
+        float Y = 0.0f;
+        double Mass = 1.0;
+        std::string Name;
+        Body* Parent = nullptr;
+
+        bool operator==(const Body&) const = default;
+    };
+
+    struct Tagged
+    {
+        ETI_STRUCT_EXT(Tagged,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Id),
+                ETI_PROPERTY(A),
+                ETI_PROPERTY(B)
+            ),
+            ETI_METHODS())
+
+        int Id = 0;
+        test_45::Counted A;
+        test_45::Counted B;
+    };
+
+    TEST_CASE("test_49")
+    {
+        const Type& type = TypeOf<Body>();
+        TypeId xId = type.GetProperty("X")->PropertyId;
+        TypeId massId = type.GetProperty("Mass")->PropertyId;
+
+        std::vector<Body> bodies;
+        bodies.reserve(100);
+        for (int i = 0; i < 100; ++i)
+            bodies.push_back({ (float)i, (float)-i, i * 2.0, "body with a name long enough to allocate " + std::to_string(i), i > 0 ? &bodies[0] : nullptr });
+
+        SoAVector<Body> soa(bodies);
+        REQUIRE(soa.GetSize() == 100);
+        REQUIRE(soa.GetColumns().size() == 5);
+        for (const SoAVector<Body>::Column& column : soa.GetColumns())
+            REQUIRE(reinterpret_cast<std::uintptr_t>(column.Data) % SoAVector<Body>::ColumnAlign == 0);
+        REQUIRE(soa.ToVector() == bodies);
+
+        // columns
+        std::span<float> xs = soa.GetColumn<float>(xId);
+        REQUIRE(xs.size() == 100);
+        REQUIRE(xs[42] == 42.0f);
+        for (float& x : xs)
+            x += 1.0f;
+        REQUIRE(soa.Get(42).X == 43.0f);
+        REQUIRE(soa.GetColumn<double>(massId)[10] == 20.0);
+        REQUIRE(soa.FindColumn(utils::GetStringHash("Unknown")) == nullptr);
+
+        // erase, set
+        soa.Erase(0, 10);
+        soa.PopBack();
+        REQUIRE(soa.GetSize() == 89);
+        REQUIRE(soa.Get(0).Name.ends_with(" 10"));
+        REQUIRE(soa.Get(0).Parent == &bodies[0]);
+        Body body;
+        body.Name = "set";
+        soa.Set(1, body);
+        REQUIRE(soa.Get(1) == body);
+
+        // copy, move
+        SoAVector<Body> copy = soa;
+        REQUIRE(copy.ToVector() == soa.ToVector());
+        SoAVector<Body> moved = std::move(copy);
+        REQUIRE(copy.IsEmpty());
+        REQUIRE(moved.GetSize() == 89);
+        copy.PushBack(body);
+        REQUIRE(copy.Get(0) == body);
+        moved.Clear();
+        REQUIRE(moved.IsEmpty());
+
+        // empty, no storage yet
+        static_assert(std::is_nothrow_move_constructible_v<SoAVector<Body>>);
+        SoAVector<Body> empty;
+        REQUIRE(empty.GetColumns().size() == 5);
+        REQUIRE(empty.GetColumn<float>(xId).empty());
+
+        // throwing copy in second non trivial column, constructed members are destructed
+        using test_45::Counted;
+        {
+            std::vector<Tagged> tagged(4);
+            REQUIRE(Counted::Live == 8);
+            Counted::ThrowAfter = 6;
+            REQUIRE_THROWS(SoAVector<Tagged>(tagged));
+            REQUIRE(Counted::Live == 8);
+
+            Counted::ThrowAfter = -1;
+            SoAVector<Tagged> soaTagged(tagged);
+            REQUIRE(Counted::Live == 16);
+            Counted::ThrowAfter = 1;
+            REQUIRE_THROWS(soaTagged.PushBack(tagged[0]));
+            REQUIRE(soaTagged.GetSize() == 4);
+            REQUIRE(Counted::Live == 16);
+
+            SoAVector<Tagged> copyTagged;
+            Counted::ThrowAfter = 5;
+            REQUIRE_THROWS(copyTagged = soaTagged);
+            REQUIRE(copyTagged.IsEmpty());
+            REQUIRE(Counted::Live == 16);
+
+            // throwing copy replacing constructed members (Set, Get and ToVector default construct first)
+            Counted::ThrowAfter = 0;
+            REQUIRE_THROWS(soaTagged.Set(0, tagged[1]));
+            REQUIRE(Counted::Live == 16);
+            Counted::ThrowAfter = 2;
+            REQUIRE_THROWS(soaTagged.Get(0));
+            REQUIRE(Counted::Live == 16);
+            Counted::ThrowAfter = 9;
+            REQUIRE_THROWS(soaTagged.ToVector());
+            REQUIRE(Counted::Live == 16);
+            Counted::ThrowAfter = -1;
+            soaTagged.Set(0, tagged[1]);
+            REQUIRE(soaTagged.ToVector().size() == 4);
+            REQUIRE(Counted::Live == 16);
+        }
+        REQUIRE(Counted::Live == 0);
+    }
+}
+
+namespace test_50
+{
+    // 12 bytes, trivially copyable
+    struct Vec3
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+    };
+
+    struct Record
+    {
+        ETI_STRUCT_EXT(Record,
+            ETI_PROPERTIES
+            (
+                ETI_PROPERTY(Flag),
+                ETI_PROPERTY(Short),
+                ETI_PROPERTY(Count),
+                ETI_PROPERTY(Value),
+                ETI_PROPERTY(Point),
+                ETI_PROPERTY(Position),
+                ETI_PROPERTY(Label)
+            ),
+            ETI_METHODS())
+
+        std::uint8_t Flag = 0;
+        std::uint16_t Short = 0;
+        std::int32_t Count = 0;
+        double Value = 0.0;
+        test_36::Point Point;
+        Vec3 Position;
+        std::string Label;
+    };
+
+    TEST_CASE("test_50")
+    {
+        const Type& type = TypeOf<Record>();
+        std::vector<Record> records(37);
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            records[i].Flag = (std::uint8_t)i;
+            records[i].Count = (std::int32_t)i * 3;
+            records[i].Value = i * 0.5;
+            records[i].Point.Y = (float)i;
+            records[i].Short = (std::uint16_t)(i * 1000);
+            records[i].Position.Z = (float)i * 2.0f;
+        }
+        static_assert(sizeof(Vec3) == 12);
+
+        // 1, 2, 4, 8 bytes and other sizes (12), counts not multiple of unroll
+        std::vector<std::uint8_t> flags(records.size());
+        type.GetProperty("Flag")->Gather(records.data(), type.Size, records.size(), flags.data());
+        std::vector<std::int32_t> counts(records.size());
+        type.GetProperty("Count")->Gather(records.data(), type.Size, records.size(), counts.data());
+        std::vector<double> values(records.size());
+        type.GetProperty("Value")->Gather(records.data(), type.Size, records.size(), values.data());
+        std::vector<test_36::Point> points(records.size());
+        type.GetProperty("Point")->Gather(records.data(), type.Size, records.size(), points.data());
+        std::vector<std::uint16_t> shorts(records.size());
+        type.GetProperty("Short")->Gather(records.data(), type.Size, records.size(), shorts.data());
+        std::vector<Vec3> positions(records.size());
+        type.GetProperty("Position")->Gather(records.data(), type.Size, records.size(), positions.data());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            REQUIRE(shorts[i] == (std::uint16_t)(i * 1000));
+            REQUIRE(positions[i].Z == (float)i * 2.0f);
+            REQUIRE(flags[i] == i);
+            REQUIRE(counts[i] == (std::int32_t)i * 3);
+            REQUIRE(values[i] == i * 0.5);
+            REQUIRE(points[i].Y == (float)i);
+        }
+
+        // scatter back, other members untouched
+        for (double& value : values)
+            value *= 2.0;
+        type.GetProperty("Value")->Scatter(records.data(), type.Size, records.size(), values.data());
+        for (std::uint16_t& value : shorts)
+            value += 1;
+        type.GetProperty("Short")->Scatter(records.data(), type.Size, records.size(), shorts.data());
+        for (Vec3& position : positions)
+            position.X = position.Z + 1.0f;
+        type.GetProperty("Position")->Scatter(records.data(), type.Size, records.size(), positions.data());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            REQUIRE(records[i].Value == i * 1.0);
+            REQUIRE(records[i].Count == (std::int32_t)i * 3);
+            REQUIRE(records[i].Short == (std::uint16_t)(i * 1000 + 1));
+            REQUIRE(records[i].Position.X == (float)i * 2.0f + 1.0f);
+            REQUIRE(records[i].Position.Z == (float)i * 2.0f);
+            REQUIRE(records[i].Flag == i);
+        }
+
+        // strided subset (every other record)
+        std::vector<std::int32_t> half(records.size() / 2);
+        type.GetProperty("Count")->Gather(records.data(), 2 * type.Size, half.size(), half.data());
+        REQUIRE(half[5] == 30);
+        type.GetProperty("Count")->Gather(nullptr, type.Size, 0, nullptr);
+    }
+}